@@ -0,0 +1,233 @@
+#include "../IDAstar/IDAstar.h"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Writes solvable 15-puzzle instances in the korf100.txt format ("id t0 ...
+// t15"), either uniformly random or by random walks from the goal. Walk
+// instances are at most `depth` moves from the goal; with --exact each one is
+// solved and kept only if its optimal length is exactly `depth`, which gives
+// difficulty-graded workloads.
+
+struct Options {
+    std::string mode = "random";     // random or walk
+    int count = 100;                 // Instances (per depth in walk mode)
+    int min_depth = 40;
+    int max_depth = 40;
+    int depth_step = 2;              // Variant 1 lengths from one goal all share a parity
+    int variant = 1;                 // Move set of the walks and of --exact
+    bool exact = false;
+    long long max_nodes = 0;         // --exact budget per candidate, 0: unlimited
+    unsigned seed = 1;
+    int first_id = 1;
+    std::string output;              // Empty: stdout
+    std::string wd_file = "../Heuristics/wd_table.bin";
+};
+
+void PrintUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [options]\n"
+              << "  --mode random|walk             Uniform random permutations or random walks (default random)\n"
+              << "  --count <n>                    Instances, per depth in walk mode (default 100)\n"
+              << "  --depth <d>|<from>-<to>        Walk length(s) (default 40)\n"
+              << "  --step <n>                     Depth step for a range (default 2)\n"
+              << "  --exact                        Keep only walks whose optimal length equals the depth\n"
+              << "  --max-nodes <n>                Node budget per --exact check (default 0, unlimited)\n"
+              << "  --variant 1|2                  Move set for walks and --exact (default 1)\n"
+              << "  --seed <n>                     Random seed (default 1)\n"
+              << "  --first-id <n>                 Number of the first instance (default 1)\n"
+              << "  --output <file>                Output file (default stdout)\n"
+              << "  --wd <file>                    Walking distance table for --exact\n";
+}
+
+void ParseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) throw std::invalid_argument("missing value for " + arg);
+            return argv[++i];
+        };
+        if (arg == "--mode") {
+            options.mode = value();
+        } else if (arg == "--count") {
+            options.count = std::stoi(value());
+        } else if (arg == "--depth") {
+            std::string depth = value();
+            size_t dash = depth.find('-');
+            options.min_depth = std::stoi(depth.substr(0, dash));
+            options.max_depth = (dash == std::string::npos) ? options.min_depth : std::stoi(depth.substr(dash + 1));
+        } else if (arg == "--step") {
+            options.depth_step = std::stoi(value());
+        } else if (arg == "--exact") {
+            options.exact = true;
+        } else if (arg == "--max-nodes") {
+            options.max_nodes = std::stoll(value());
+        } else if (arg == "--variant") {
+            options.variant = std::stoi(value());
+        } else if (arg == "--seed") {
+            options.seed = std::stoul(value());
+        } else if (arg == "--first-id") {
+            options.first_id = std::stoi(value());
+        } else if (arg == "--output") {
+            options.output = value();
+        } else if (arg == "--wd") {
+            options.wd_file = value();
+        } else {
+            throw std::invalid_argument("unknown option " + arg);
+        }
+    }
+    if (options.mode != "random" && options.mode != "walk") throw std::invalid_argument("mode must be random or walk");
+    if (options.variant != 1 && options.variant != 2) throw std::invalid_argument("variant must be 1 or 2");
+    if (options.count < 0 || options.min_depth < 0 || options.max_depth < options.min_depth || options.depth_step < 1) {
+        throw std::invalid_argument("invalid count or depth range");
+    }
+}
+
+// korf100.txt layout: id right-aligned in 2 columns, tiles from column 6
+void WriteInstance(std::ostream& out, int id, const std::array<int, 16>& tiles) {
+    std::ostringstream label;
+    label << std::setw(2) << id;
+    out << label.str() << std::string(std::max<int>(1, 5 - label.str().size()), ' ');
+    for (int i = 0; i < 16; ++i) out << (i ? " " : "") << tiles[i];
+    out << "\n";
+}
+
+// Uniform over the solvable half of all permutations: shuffle, then fix the
+// parity by swapping two non-blank tiles if needed
+std::array<int, 16> RandomInstance(std::mt19937& rng) {
+    std::array<int, 16> tiles;
+    for (int i = 0; i < 16; ++i) tiles[i] = i;
+    std::shuffle(tiles.begin(), tiles.end(), rng);
+    if (!Puzzle::IsSolvable(tiles)) {
+        int a = (tiles[0] == 0) ? 1 : 0;
+        int b = (tiles[a + 1] == 0) ? a + 2 : a + 1;
+        std::swap(tiles[a], tiles[b]);
+    }
+    return tiles;
+}
+
+// Random walk of `depth` moves from the goal that never undoes its last move
+template <typename Variant>
+std::array<int, 16> RandomWalk(int depth, std::mt19937& rng) {
+    Board board;
+    for (int i = 0; i < 16; ++i) board.tiles[i] = i;
+    board.blank = 0;
+    int last_dir = -1;
+    for (int step = 0; step < depth; ++step) {
+        const MoveList& moves = Variant::Moves(board.blank);
+        const Move* move;
+        do {
+            move = &moves.moves[rng() % moves.size];
+        } while (last_dir >= 0 && move->action.dir == Opposite(static_cast<Direction>(last_dir)));
+        board.Apply(*move);
+        last_dir = move->action.dir;
+    }
+    return board.tiles;
+}
+
+template <typename Variant>
+int Generate(const Options& options, std::ostream& out) {
+    std::mt19937 rng(options.seed);
+    int id = options.first_id;
+
+    if (options.mode == "random") {
+        for (int i = 0; i < options.count; ++i) WriteInstance(out, id++, RandomInstance(rng));
+        return 0;
+    }
+    if (!options.exact) {
+        for (int depth = options.min_depth; depth <= options.max_depth; depth += options.depth_step) {
+            for (int i = 0; i < options.count; ++i) WriteInstance(out, id++, RandomWalk<Variant>(depth, rng));
+        }
+        return 0;
+    }
+
+    // Optimal lengths for --exact: walking distance with FSM pruning
+    WalkingDistance walking_distance;
+    walking_distance.LoadOrBuild(options.wd_file);
+    MovePruningFSM move_pruning;
+    move_pruning.LoadOrBuild("../Search/fsm_v" + std::to_string(Variant::kNumber) + ".bin", Variant::kNumber,
+                             MovePruningFSM::DefaultDepth(Variant::kNumber));
+    WalkingDistanceHeuristic<Variant> heuristic(&walking_distance);
+    IDAstar<Variant, WalkingDistanceHeuristic<Variant>> solver(heuristic, &move_pruning);
+    SearchLimits limits;
+    limits.max_nodes = options.max_nodes;
+    std::ofstream no_output;
+
+    // One bucket per target depth. Random walks mostly end closer to the goal
+    // than their length, so a bucket's walk length grows after every walk that
+    // came out too short (by 2 in variant 1, where a state's solution lengths
+    // all have the parity of its walks); a walk that lands in another unfilled
+    // bucket is kept there.
+    const int length_step = (Variant::kNumber == 1) ? 2 : 1;
+    struct Bucket {
+        int walk_length;
+        long long walks = 0;
+        std::vector<std::array<int, 16>> instances;
+    };
+    std::map<int, Bucket> buckets;
+    for (int depth = options.min_depth; depth <= options.max_depth; depth += options.depth_step) {
+        buckets[depth].walk_length = depth;
+    }
+    auto full = [&](const Bucket& bucket) { return static_cast<int>(bucket.instances.size()) >= options.count; };
+
+    long long walks = 0;
+    for (bool pending = true; pending; ) {
+        pending = false;
+        for (auto& [depth, bucket] : buckets) {
+            if (full(bucket)) continue;
+            pending = true;
+            std::array<int, 16> tiles = RandomWalk<Variant>(bucket.walk_length, rng);
+            ++bucket.walks;
+            ++walks;
+
+            Puzzle puzzle(tiles, Variant::kNumber);
+            auto result = solver.Solve(puzzle, [](int, const IterationStats&, std::ofstream&) {}, 0, no_output, limits);
+            if (solver.Status() != SolveStatus::Solved) continue;
+            int length = std::get<1>(result);
+            if (length < depth) bucket.walk_length += length_step;
+
+            auto found = buckets.find(length);
+            if (found != buckets.end() && !full(found->second)) {
+                found->second.instances.push_back(tiles);
+                if (full(found->second)) {
+                    std::cerr << "depth " << length << ": " << options.count << " instances (walk length "
+                              << found->second.walk_length << ", " << found->second.walks << " walks)\n";
+                }
+            }
+            if (walks % 1000 == 0) std::cerr << walks << " walks solved\n";
+        }
+    }
+
+    for (const auto& [depth, bucket] : buckets) {
+        for (const auto& tiles : bucket.instances) WriteInstance(out, id++, tiles);
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    try {
+        ParseOptions(argc, argv, options);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    std::ofstream file;
+    if (!options.output.empty()) {
+        file.open(options.output);
+        if (!file) {
+            std::cerr << "Failed to open " << options.output << "\n";
+            return 1;
+        }
+    }
+    std::ostream& out = options.output.empty() ? std::cout : file;
+    return (options.variant == 1) ? Generate<Variant1>(options, out) : Generate<Variant2>(options, out);
+}
@@ -0,0 +1,427 @@
+#include "../IDAstar/IDAstar.h"
+#include "../IDAstar/InstanceStream.h"
+#include "../Search/PerfCounters.h"
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// End-to-end regression run over Korf's 100 instances. Each selected solver
+// configuration solves the chosen puzzles; solution lengths are checked
+// against the known optimal lengths and node counts and times are compared
+// with a stored baseline. The search is deterministic (FSM pruning, no
+// transposition table), so any node count change means the pruning or the
+// heuristic changed.
+
+struct Options {
+    std::vector<std::string> solvers{"v1_wd", "v2_wd"};
+    std::string puzzles;                           // "1,5,9-12"; empty: see easiest
+    int easiest = 20;                              // 0: all 100
+    int num_threads = 0;
+    std::string instance_file = "../Data/korf100.txt";
+    std::string reference_file = "korf100_reference.csv";
+    std::string baseline_file = "korf100_baseline.csv";
+    bool update_baseline = false;
+    double max_node_increase = -1.0;               // Percent; negative: report only
+    double max_time = 0.0;                         // Seconds per puzzle, 0: unlimited
+    bool perf = false;                             // Hardware counters per solve
+    std::string wd_file = "../Heuristics/wd_table.bin";
+    std::vector<std::string> pdb_files[3];         // Per variant
+    std::vector<std::vector<int>> patterns[3];
+};
+
+struct BaselineEntry {
+    int solution_length;
+    long long nodes_expanded;
+    long long nodes_generated;
+    double time;
+};
+
+using Baseline = std::map<std::pair<std::string, int>, BaselineEntry>; // (solver, puzzle)
+
+struct RunResult {
+    int puzzle_num;
+    SolveStatus status;
+    int solution_length;
+    long long nodes_expanded;
+    long long nodes_generated;
+    double time;
+    PerfSample perf;
+};
+
+std::vector<std::string> Split(const std::string& text, char separator) {
+    std::vector<std::string> parts;
+    std::istringstream iss(text);
+    std::string part;
+    while (std::getline(iss, part, separator)) {
+        if (!part.empty()) parts.push_back(part);
+    }
+    return parts;
+}
+
+std::vector<int> ParsePattern(const std::string& pattern_str) {
+    std::vector<int> pattern;
+    std::string cleaned = pattern_str;
+    if (!cleaned.empty() && cleaned.front() == '{') cleaned = cleaned.substr(1, cleaned.size() - 2);
+    for (const auto& token : Split(cleaned, ',')) pattern.push_back(std::stoi(token));
+    return pattern;
+}
+
+// "1,5,9-12" -> {1, 5, 9, 10, 11, 12}
+std::vector<int> ParsePuzzleList(const std::string& list) {
+    std::vector<int> puzzles;
+    for (const auto& part : Split(list, ',')) {
+        size_t dash = part.find('-');
+        int first = std::stoi(part.substr(0, dash));
+        int last = (dash == std::string::npos) ? first : std::stoi(part.substr(dash + 1));
+        for (int p = first; p <= last; ++p) puzzles.push_back(p);
+    }
+    return puzzles;
+}
+
+// puzzle -> optimal length per variant (index 1 and 2, -1 if unknown)
+std::map<int, std::array<int, 3>> LoadReference(const std::string& filepath) {
+    std::map<int, std::array<int, 3>> reference;
+    std::ifstream file(filepath);
+    std::string line;
+    std::getline(file, line); // Header
+    while (std::getline(file, line)) {
+        auto fields = Split(line, ',');
+        if (fields.size() < 3) continue;
+        reference[std::stoi(fields[0])] = {-1, std::stoi(fields[1]), std::stoi(fields[2])};
+    }
+    return reference;
+}
+
+Baseline LoadBaseline(const std::string& filepath) {
+    Baseline baseline;
+    std::ifstream file(filepath);
+    std::string line;
+    std::getline(file, line); // Header
+    while (std::getline(file, line)) {
+        auto fields = Split(line, ',');
+        if (fields.size() < 6) continue;
+        baseline[{fields[0], std::stoi(fields[1])}] =
+            BaselineEntry{std::stoi(fields[2]), std::stoll(fields[3]), std::stoll(fields[4]), std::stod(fields[5])};
+    }
+    return baseline;
+}
+
+bool SaveBaseline(const std::string& filepath, const Baseline& baseline) {
+    std::ofstream file(filepath);
+    if (!file) return false;
+    file << "solver,puzzle,solution_length,nodes_expanded,nodes_generated,time_s\n";
+    for (const auto& [key, entry] : baseline) {
+        file << key.first << ',' << key.second << ',' << entry.solution_length << ',' << entry.nodes_expanded << ','
+             << entry.nodes_generated << ',' << std::fixed << std::setprecision(3) << entry.time << '\n';
+    }
+    return true;
+}
+
+// Solves the instances on a pool of threads, one solver per thread
+template <typename Variant, typename Heuristic>
+std::vector<RunResult> SolveInstances(const Heuristic& heuristic, const MovePruningFSM* move_pruning,
+                                      const std::vector<Instance>& instances, const Options& options) {
+    std::vector<RunResult> results(instances.size());
+    std::atomic<size_t> next{0};
+    auto worker = [&]() {
+        IDAstar<Variant, Heuristic> solver(heuristic, move_pruning);
+        std::unique_ptr<PerfCounters> perf;
+        if (options.perf) perf.reset(new PerfCounters());
+        SearchLimits limits;
+        limits.max_seconds = options.max_time;
+        std::ofstream no_output;
+        for (size_t i = next++; i < instances.size(); i = next++) {
+            Puzzle puzzle(instances[i].tiles, Variant::kNumber);
+            if (perf) perf->Start();
+            auto result = solver.Solve(puzzle, [](int, const IterationStats&, std::ofstream&) {}, 0, no_output, limits);
+            results[i] = RunResult{instances[i].id, solver.Status(), std::get<1>(result), std::get<3>(result),
+                                   std::get<4>(result), std::get<2>(result), perf ? perf->Stop() : PerfSample()};
+        }
+    };
+    std::vector<std::thread> threads;
+    for (int t = 0; t < options.num_threads; ++t) threads.emplace_back(worker);
+    for (auto& thread : threads) thread.join();
+    return results;
+}
+
+template <typename Variant>
+bool SolveWith(const std::string& heuristic_name, const std::vector<Instance>& instances, const Options& options,
+               std::vector<RunResult>& results) {
+    MovePruningFSM move_pruning;
+    move_pruning.LoadOrBuild("../Search/fsm_v" + std::to_string(Variant::kNumber) + ".bin", Variant::kNumber,
+                             MovePruningFSM::DefaultDepth(Variant::kNumber));
+    if (heuristic_name == "md") {
+        results = SolveInstances<Variant>(ManhattanHeuristic<Variant>(), &move_pruning, instances, options);
+    } else if (heuristic_name == "wd") {
+        WalkingDistance walking_distance;
+        walking_distance.LoadOrBuild(options.wd_file);
+        results = SolveInstances<Variant>(WalkingDistanceHeuristic<Variant>(&walking_distance), &move_pruning,
+                                          instances, options);
+    } else if (heuristic_name == "pdb") {
+        const auto& files = options.pdb_files[Variant::kNumber];
+        if (files.empty()) {
+            std::cerr << "v" << Variant::kNumber << "_pdb needs --pdb-v" << Variant::kNumber << " <file> <pattern>\n";
+            return false;
+        }
+        std::vector<PatternDatabase> databases(files.size());
+        for (size_t d = 0; d < files.size(); ++d) {
+            if (!databases[d].Load(files[d], options.patterns[Variant::kNumber][d], Variant::kNumber)) return false;
+        }
+        results = SolveInstances<Variant>(PDBHeuristic<Variant>(&databases), &move_pruning, instances, options);
+    } else {
+        std::cerr << "Unknown heuristic " << heuristic_name << "\n";
+        return false;
+    }
+    return true;
+}
+
+void ParseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) throw std::invalid_argument("missing value for " + arg);
+            return argv[++i];
+        };
+        if (arg == "--solvers") {
+            options.solvers = Split(value(), ',');
+        } else if (arg == "--puzzles") {
+            options.puzzles = value();
+        } else if (arg == "--easiest") {
+            options.easiest = std::stoi(value());
+        } else if (arg == "--all") {
+            options.easiest = 0;
+        } else if (arg == "--threads") {
+            options.num_threads = std::stoi(value());
+        } else if (arg == "--instances") {
+            options.instance_file = value();
+        } else if (arg == "--reference") {
+            options.reference_file = value();
+        } else if (arg == "--baseline") {
+            options.baseline_file = value();
+        } else if (arg == "--update-baseline") {
+            options.update_baseline = true;
+        } else if (arg == "--max-node-increase") {
+            options.max_node_increase = std::stod(value());
+        } else if (arg == "--max-time") {
+            options.max_time = std::stod(value());
+        } else if (arg == "--perf") {
+            options.perf = true;
+        } else if (arg == "--huge-pages") {
+            HugePages::Policy policy;
+            if (!HugePages::ParsePolicy(value(), policy)) throw std::invalid_argument("huge pages must be off, thp or explicit");
+            HugePages::SetPolicy(policy);
+        } else if (arg == "--wd") {
+            options.wd_file = value();
+        } else if (arg == "--pdb-v1" || arg == "--pdb-v2") {
+            int variant = arg.back() - '0';
+            options.pdb_files[variant].push_back(value());
+            options.patterns[variant].push_back(ParsePattern(value()));
+        } else {
+            throw std::invalid_argument("unknown option " + arg);
+        }
+    }
+    if (options.num_threads <= 0) {
+        options.num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+}
+
+// The puzzles to run for one solver: an explicit list, or the `easiest`
+// puzzles by this solver's baseline node count. Without enough baseline
+// entries for the solver there is no ranking to pick them by: throws
+// std::invalid_argument.
+std::vector<Instance> SelectInstances(const std::vector<Instance>& all, const std::string& solver,
+                                      const Baseline& baseline, const Options& options) {
+    std::vector<Instance> selected;
+    if (!options.puzzles.empty()) {
+        for (int puzzle_num : ParsePuzzleList(options.puzzles)) {
+            for (const auto& instance : all) {
+                if (instance.id == puzzle_num) selected.push_back(instance);
+            }
+        }
+        return selected;
+    }
+    selected = all;
+    if (options.easiest <= 0 || options.easiest >= static_cast<int>(all.size())) return selected;
+
+    // Only puzzles with a baseline entry can be ranked
+    selected.erase(std::remove_if(selected.begin(), selected.end(),
+                                  [&](const Instance& instance) { return !baseline.count({solver, instance.id}); }),
+                   selected.end());
+    if (static_cast<int>(selected.size()) < options.easiest) {
+        throw std::invalid_argument("--easiest " + std::to_string(options.easiest) + " needs baseline entries for " +
+                                    solver + ", " + options.baseline_file + " has " +
+                                    std::to_string(selected.size()) + "; record them with --all or --puzzles and " +
+                                    "--update-baseline");
+    }
+    auto nodes = [&](const Instance& instance) { return baseline.at({solver, instance.id}).nodes_expanded; };
+    std::stable_sort(selected.begin(), selected.end(),
+                     [&](const Instance& a, const Instance& b) { return nodes(a) < nodes(b); });
+    selected.resize(options.easiest);
+    // Hardest first keeps the thread pool busy until the end
+    std::reverse(selected.begin(), selected.end());
+    return selected;
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    try {
+        ParseOptions(argc, argv, options);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n"
+                  << "Usage: " << argv[0] << " [--solvers v1_md,v1_wd,v1_pdb,v2_md,v2_wd,v2_pdb] [--easiest <n> | --all | --puzzles <list>]\n"
+                  << "       [--threads <n>] [--baseline <file>] [--update-baseline] [--max-node-increase <pct>]\n"
+                  << "       [--max-time <s>] [--reference <file>] [--instances <file>] [--wd <file>] [--perf]\n"
+                  << "       [--huge-pages off|thp|explicit]\n"
+                  << "       [--pdb-v1 <file> <pattern>]... [--pdb-v2 <file> <pattern>]...\n";
+        return 1;
+    }
+
+    std::vector<Instance> all;
+    {
+        std::ifstream file(options.instance_file);
+        if (!file) {
+            std::cerr << "Failed to open " << options.instance_file << "\n";
+            return 1;
+        }
+        std::string line;
+        while (std::getline(file, line)) {
+            Instance instance;
+            if (ParseInstance(line, static_cast<int>(all.size()) + 1, instance)) all.push_back(instance);
+        }
+    }
+    if (options.perf) {
+        PerfCounters probe;
+        if (!probe.Available()) {
+            std::cerr << "Hardware counters unavailable, --perf ignored: " << probe.Error() << "\n";
+            options.perf = false;
+        }
+    }
+
+    auto reference = LoadReference(options.reference_file);
+    Baseline baseline = LoadBaseline(options.baseline_file);
+    Baseline updated = baseline;
+
+    int wrong_lengths = 0;
+    int node_regressions = 0;
+    for (const auto& solver : options.solvers) {
+        if (solver.size() < 4 || solver[0] != 'v' || (solver[1] != '1' && solver[1] != '2') || solver[2] != '_') {
+            std::cerr << "Solver names look like v1_wd, not " << solver << "\n";
+            return 1;
+        }
+        const int variant = solver[1] - '0';
+        std::vector<Instance> instances;
+        try {
+            instances = SelectInstances(all, solver, baseline, options);
+        } catch (const std::invalid_argument& e) {
+            std::cerr << "Error: " << e.what() << "\n";
+            return 1;
+        }
+        std::cout << "== " << solver << ": " << instances.size() << " puzzles on " << options.num_threads
+                  << " threads\n";
+
+        std::vector<RunResult> results;
+        auto start = std::chrono::steady_clock::now();
+        bool ok = (variant == 1) ? SolveWith<Variant1>(solver.substr(3), instances, options, results)
+                                 : SolveWith<Variant2>(solver.substr(3), instances, options, results);
+        if (!ok) return 1;
+        std::chrono::duration<double> wall = std::chrono::steady_clock::now() - start;
+        std::sort(results.begin(), results.end(),
+                  [](const RunResult& a, const RunResult& b) { return a.puzzle_num < b.puzzle_num; });
+
+        std::cout << std::setw(6) << "puzzle" << std::setw(8) << "length" << std::setw(9) << "optimal"
+                  << std::setw(15) << "expanded" << std::setw(10) << "delta" << std::setw(10) << "time_s"
+                  << std::setw(12) << "Mnodes/s" << "\n";
+        long long total_nodes = 0;
+        double total_time = 0.0;
+        // Only puzzles solved now and present in the baseline enter the comparison
+        long long compared_nodes = 0, compared_baseline_nodes = 0;
+        double compared_time = 0.0, compared_baseline_time = 0.0;
+        PerfSample total_perf = PerfSample::Zero();
+        int compared = 0;
+        for (const auto& result : results) {
+            auto ref = reference.find(result.puzzle_num);
+            int optimal = (ref == reference.end()) ? -1 : ref->second[variant];
+            auto base = baseline.find({solver, result.puzzle_num});
+
+            std::string verdict;
+            if (result.status != SolveStatus::Solved) {
+                verdict = std::string("  ") + ToString(result.status);
+            } else if (optimal >= 0 && result.solution_length != optimal) {
+                verdict = "  WRONG LENGTH";
+                ++wrong_lengths;
+            }
+
+            std::ostringstream delta;
+            if (base != baseline.end() && result.status == SolveStatus::Solved) {
+                double pct = 100.0 * (result.nodes_expanded - base->second.nodes_expanded) /
+                             std::max(1LL, base->second.nodes_expanded);
+                delta << std::showpos << std::fixed << std::setprecision(1) << pct << "%";
+                if (options.max_node_increase >= 0.0 && pct > options.max_node_increase) {
+                    verdict += "  NODE REGRESSION";
+                    ++node_regressions;
+                }
+                compared_nodes += result.nodes_expanded;
+                compared_baseline_nodes += base->second.nodes_expanded;
+                compared_time += result.time;
+                compared_baseline_time += base->second.time;
+                ++compared;
+            } else {
+                delta << "-";
+            }
+
+            std::cout << std::setw(6) << result.puzzle_num << std::setw(8) << result.solution_length
+                      << std::setw(9) << (optimal >= 0 ? std::to_string(optimal) : "?") << std::setw(15)
+                      << result.nodes_expanded << std::setw(10) << delta.str() << std::setw(10) << std::fixed
+                      << std::setprecision(3) << result.time << std::setw(12) << std::setprecision(2)
+                      << (result.time > 0 ? result.nodes_expanded / result.time / 1e6 : 0.0) << verdict << "\n";
+
+            total_nodes += result.nodes_expanded;
+            total_time += result.time;
+            total_perf += result.perf;
+            if (options.update_baseline && result.status == SolveStatus::Solved) {
+                updated[{solver, result.puzzle_num}] = BaselineEntry{result.solution_length, result.nodes_expanded,
+                                                                     result.nodes_generated, result.time};
+            }
+        }
+
+        std::cout << "total: " << total_nodes << " expanded, " << std::fixed << std::setprecision(2) << total_time
+                  << "s solver time, " << wall.count() << "s wall, "
+                  << (total_time > 0 ? total_nodes / total_time / 1e6 : 0.0) << " Mnodes/s per thread\n";
+        if (compared > 0) {
+            std::cout << "vs baseline (" << compared << " puzzles): nodes " << std::showpos << std::setprecision(2)
+                      << 100.0 * (compared_nodes - compared_baseline_nodes) / std::max(1LL, compared_baseline_nodes)
+                      << "%" << std::noshowpos << ", time x" << std::setprecision(2)
+                      << (compared_baseline_time > 0 ? compared_time / compared_baseline_time : 0.0) << "\n";
+        }
+        if (options.perf) {
+            std::cout << "counters: ";
+            total_perf.Print(std::cout, total_nodes);
+        }
+        std::cout << "\n";
+    }
+
+    if (options.update_baseline) {
+        if (!SaveBaseline(options.baseline_file, updated)) {
+            std::cerr << "Failed to write " << options.baseline_file << "\n";
+            return 1;
+        }
+        std::cout << "Baseline written to " << options.baseline_file << "\n";
+    }
+    if (wrong_lengths > 0 || node_regressions > 0) {
+        std::cout << "FAILED: " << wrong_lengths << " wrong solution lengths, " << node_regressions
+                  << " node count regressions\n";
+        return 2;
+    }
+    std::cout << "PASSED\n";
+    return 0;
+}
@@ -0,0 +1,366 @@
+#include "../IDAstar/Heuristic.h"
+#include "../IDAstar/Variant.h"
+#include "../PDB/GeneratePDB.h"
+#include "../Puzzle/Puzzle.h"
+#include "../Search/Ranking.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Every heap allocation of the process goes through this counter; a kernel's
+// allocations/op is the counter delta over its timed loop
+std::atomic<long long> allocation_count{0};
+
+void* operator new(std::size_t size) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace Benchmark {
+    struct Options {
+        long long ops = 20000000;          // Timed operations per kernel
+        int num_states = 4096;             // Random states cycled through (power of two)
+        int walk_length = 400;             // Random walk length per state
+        unsigned seed = 1;
+        std::string filter;                // Run only kernels whose name contains this
+        std::string wd_file = "../Heuristics/wd_table.bin";
+        std::vector<std::string> pdb_files;
+        std::vector<std::vector<int>> patterns;
+        std::string csv_file;
+    };
+
+    struct Result {
+        std::string name;
+        double ns_per_op;
+        double allocs_per_op;
+    };
+
+    // A random state per slot plus one legal move from it, so that kernels
+    // see realistic boards and unpredictable move directions
+    struct Sample {
+        Board board;
+        const Move* move;
+    };
+
+    std::vector<Sample> MakeSamples(const Options& options, std::mt19937& rng) {
+        std::vector<Sample> samples(options.num_states);
+        for (auto& sample : samples) {
+            Board& board = sample.board;
+            for (int i = 0; i < 16; ++i) board.tiles[i] = i;
+            board.blank = 0;
+            for (int step = 0; step < options.walk_length; ++step) {
+                const MoveList& moves = Variant1::Moves(board.blank);
+                board.Apply(moves.moves[rng() % moves.size]);
+            }
+            const MoveList& moves = Variant1::Moves(board.blank);
+            sample.move = &moves.moves[rng() % moves.size];
+        }
+        return samples;
+    }
+
+    // Same move, but from the variant-2 table (slides of up to 3 tiles)
+    const Move* Variant2Move(const Board& board, std::mt19937& rng) {
+        const MoveList& moves = Variant2::Moves(board.blank);
+        return &moves.moves[rng() % moves.size];
+    }
+
+    class Runner {
+    public:
+        explicit Runner(const Options& options) : options(options), checksum(0) {}
+
+        // kernel(i) performs one operation on sample i and returns a value
+        // folded into a checksum, so the work cannot be optimized away
+        void Run(const std::string& name, const std::function<uint64_t(long long, int)>& kernel) {
+            if (!options.filter.empty() && name.find(options.filter) == std::string::npos) return;
+            const int mask = options.num_states - 1;
+            const long long warmup = options.ops / 10;
+            for (long long op = 0; op < warmup; ++op) checksum += kernel(op, op & mask);
+
+            long long allocations_before = allocation_count.load(std::memory_order_relaxed);
+            auto start = std::chrono::steady_clock::now();
+            for (long long op = 0; op < options.ops; ++op) checksum += kernel(op, op & mask);
+            std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+            long long allocations = allocation_count.load(std::memory_order_relaxed) - allocations_before;
+
+            Result result{name, elapsed.count() / options.ops, static_cast<double>(allocations) / options.ops};
+            std::cout << std::left << std::setw(36) << result.name << std::right << std::fixed
+                      << std::setprecision(2) << std::setw(10) << result.ns_per_op << " ns/op"
+                      << std::setw(10) << result.allocs_per_op << " allocs/op\n";
+            results.push_back(result);
+        }
+
+        const std::vector<Result>& Results() const { return results; }
+        uint64_t Checksum() const { return checksum; }
+
+    private:
+        const Options& options;
+        std::vector<Result> results;
+        uint64_t checksum;
+    };
+
+    // Old search core: Puzzle objects and their action lists
+    void RunPuzzleKernels(Runner& runner, const std::vector<Sample>& samples) {
+        std::vector<Puzzle> puzzles;
+        std::vector<Action> actions;
+        for (const auto& sample : samples) {
+            puzzles.emplace_back(sample.board.tiles, 1);
+            actions.push_back(sample.move->action);
+        }
+
+        runner.Run("Puzzle::ApplyAction+Undo", [&](long long, int i) -> uint64_t {
+            puzzles[i].ApplyAction(actions[i]);
+            puzzles[i].UndoAction(actions[i]);
+            return puzzles[i].GetBlankPosition().second;
+        });
+        runner.Run("Puzzle::GetPossibleActions", [&](long long, int i) -> uint64_t {
+            return puzzles[i].GetPossibleActions().size();
+        });
+    }
+
+    // Unified solver: precomputed move table and Board
+    void RunBoardKernels(Runner& runner, std::vector<Sample> samples) {
+        runner.Run("Board::Apply+Undo", [&](long long, int i) -> uint64_t {
+            Board& board = samples[i].board;
+            board.Apply(*samples[i].move);
+            board.Undo(*samples[i].move);
+            return board.blank;
+        });
+        runner.Run("Variant1::Moves", [&](long long, int i) -> uint64_t {
+            return Variant1::Moves(samples[i].board.blank).size;
+        });
+    }
+
+    // GeneratePDB ranking, as used while building a 7-tile PDB (closed set
+    // ranks include the blank)
+    class RankingKernels {
+    public:
+        static void Run(Runner& runner, const std::vector<Sample>& samples) {
+            GeneratePDB pdb({0, 1, 2, 3, 4, 5, 6, 7}, 1, "unused.bin");
+            pdb.RemoveElemFromPattern(0);
+            pdb.PreComputeMultipliers(pdb.sorted_pattern.size());
+
+            std::vector<std::vector<int>> abstract_states;
+            std::vector<uint64_t> ranks;
+            for (const auto& sample : samples) {
+                abstract_states.push_back(pdb.GetDual(sample.board.tiles, 1));
+                ranks.push_back(pdb.compute_rank(abstract_states.back(), 1));
+            }
+
+            runner.Run("GeneratePDB::compute_rank", [&](long long, int i) -> uint64_t {
+                return pdb.compute_rank(abstract_states[i], 1);
+            });
+            runner.Run("GeneratePDB::UnrankState", [&](long long, int i) -> uint64_t {
+                return pdb.UnrankState(ranks[i], true)[0];
+            });
+
+            // Eight closed-set states per op, one per lane, as BuildPDB ranks a
+            // node's children
+            const int num_tiles = static_cast<int>(pdb.sorted_closed_pattern.size());
+            std::vector<Ranking::Lanes> batches(samples.size() / Ranking::kLanes);
+            for (size_t b = 0; b < batches.size(); ++b) {
+                for (int c = 0; c < Ranking::kLanes; ++c) {
+                    for (int row = 0; row < num_tiles; ++row) {
+                        batches[b].positions[row][c] = abstract_states[b * Ranking::kLanes + c][row];
+                        batches[b].multipliers[row][c] = static_cast<uint32_t>(pdb.closed_multipliers[row]);
+                    }
+                }
+            }
+            if (batches.empty()) return;
+            const int batch_mask = static_cast<int>(batches.size()) - 1;
+            uint64_t lane_ranks[Ranking::kLanes];
+            runner.Run("Ranking::RankScalar x8", [&](long long, int i) -> uint64_t {
+                Ranking::RankScalar(batches[i & batch_mask], num_tiles, 0xFF, lane_ranks);
+                return lane_ranks[i & 7];
+            });
+            if (Ranking::Avx2Supported()) {
+                runner.Run("Ranking::Rank[avx2] x8", [&](long long, int i) -> uint64_t {
+                    Ranking::Rank(batches[i & batch_mask], num_tiles, 0xFF, lane_ranks);
+                    return lane_ranks[i & 7];
+                });
+            }
+        }
+    };
+
+    // Root evaluates from scratch, Child is the per-node incremental update
+    template <typename Heuristic>
+    void RunHeuristicKernels(Runner& runner, const std::string& name, const Heuristic& heuristic,
+                             const std::vector<Sample>& samples, const std::vector<const Move*>& moves) {
+        std::vector<typename Heuristic::State> states;
+        for (const auto& sample : samples) states.push_back(heuristic.Root(sample.board));
+
+        runner.Run(name + "::Root", [&](long long, int i) -> uint64_t {
+            return heuristic.Value(heuristic.Root(samples[i].board));
+        });
+        runner.Run(name + "::Child", [&](long long, int i) -> uint64_t {
+            return heuristic.Value(heuristic.Child(states[i], samples[i].board, *moves[i]));
+        });
+    }
+
+    // Every child of a node, evaluated one at a time (Child) or as the search
+    // does it, PrepareChildren before the first FinishChild, with each
+    // ranking kernel
+    template <typename Variant, typename Heuristic>
+    void RunExpansionKernels(Runner& runner, const std::string& name, const Heuristic& heuristic,
+                             const std::vector<Sample>& samples) {
+        std::vector<typename Heuristic::State> states;
+        for (const auto& sample : samples) states.push_back(heuristic.Root(sample.board));
+
+        runner.Run(name + "::Expand", [&](long long, int i) -> uint64_t {
+            const MoveList& moves = Variant::Moves(samples[i].board.blank);
+            uint64_t sum = 0;
+            for (int m = 0; m < moves.size; ++m) {
+                sum += heuristic.Value(heuristic.Child(states[i], samples[i].board, moves.moves[m]));
+            }
+            return sum;
+        });
+        std::vector<Ranking::Kernel> kernels{Ranking::Kernel::Scalar};
+        if (Ranking::Avx2Supported()) kernels.push_back(Ranking::Kernel::Avx2);
+        const Ranking::Kernel detected = Ranking::Active();
+        for (Ranking::Kernel kernel : kernels) {
+            Ranking::SetKernel(kernel);
+            runner.Run(name + "::ExpandPrefetched[" + Ranking::ToString(kernel) + "]", [&](long long, int i) -> uint64_t {
+                const MoveList& moves = Variant::Moves(samples[i].board.blank);
+                const Move* child_moves[Variant::kMaxChildren] = {};
+                for (int m = 0; m < moves.size; ++m) child_moves[m] = &moves.moves[m];
+                typename Heuristic::State children[Variant::kMaxChildren];
+                heuristic.PrepareChildren(states[i], samples[i].board, child_moves, moves.size, children);
+                uint64_t sum = 0;
+                for (int m = 0; m < moves.size; ++m) {
+                    heuristic.FinishChild(children[m]);
+                    sum += heuristic.Value(children[m]);
+                }
+                return sum;
+            });
+        }
+        Ranking::SetKernel(detected);
+    }
+
+    std::vector<int> ParsePattern(const std::string& pattern_str) {
+        std::vector<int> pattern;
+        std::string cleaned = pattern_str;
+        if (!cleaned.empty() && cleaned.front() == '{') cleaned = cleaned.substr(1, cleaned.size() - 2);
+        std::istringstream iss(cleaned);
+        std::string token;
+        while (std::getline(iss, token, ',')) pattern.push_back(std::stoi(token));
+        return pattern;
+    }
+
+    bool ParseOptions(int argc, char* argv[], Options& options) {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (i + 1 >= argc) return false;
+            if (arg == "--ops") {
+                options.ops = std::stoll(argv[++i]);
+            } else if (arg == "--states") {
+                options.num_states = std::stoi(argv[++i]);
+            } else if (arg == "--seed") {
+                options.seed = std::stoul(argv[++i]);
+            } else if (arg == "--filter") {
+                options.filter = argv[++i];
+            } else if (arg == "--wd") {
+                options.wd_file = argv[++i];
+            } else if (arg == "--csv") {
+                options.csv_file = argv[++i];
+            } else if (arg == "--huge-pages") {
+                HugePages::Policy policy;
+                if (!HugePages::ParsePolicy(argv[++i], policy)) return false;
+                HugePages::SetPolicy(policy);
+            } else if (arg == "--pdb" && i + 2 < argc) {
+                options.pdb_files.push_back(argv[++i]);
+                options.patterns.push_back(ParsePattern(argv[++i]));
+            } else {
+                return false;
+            }
+        }
+        // Sample indices are taken modulo a power of two
+        return options.ops > 0 && options.num_states > 0 && (options.num_states & (options.num_states - 1)) == 0;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    using namespace Benchmark;
+
+    Options options;
+    if (!ParseOptions(argc, argv, options)) {
+        std::cerr << "Usage: " << argv[0] << " [--ops <n>] [--states <power of 2>] [--seed <n>] [--filter <name>]\n"
+                  << "       [--wd <file>] [--pdb <file> <pattern>]... [--csv <file>] [--huge-pages off|thp|explicit]\n";
+        return 1;
+    }
+
+    std::mt19937 rng(options.seed);
+    std::vector<Sample> samples = MakeSamples(options, rng);
+    std::vector<const Move*> moves_v1, moves_v2;
+    for (const auto& sample : samples) {
+        moves_v1.push_back(sample.move);
+        moves_v2.push_back(Variant2Move(sample.board, rng));
+    }
+
+    WalkingDistance walking_distance;
+    walking_distance.LoadOrBuild(options.wd_file);
+
+    // Without --pdb, a 6-6-3 split filled with random values: the same
+    // ranking work and a table well beyond the caches, without PDB files
+    std::vector<PatternDatabase> databases;
+    if (options.pdb_files.empty()) {
+        for (const auto& pattern : std::vector<std::vector<int>>{{1, 2, 3, 4, 5, 6}, {7, 8, 9, 10, 11, 12}, {13, 14, 15}}) {
+            PatternDatabase database;
+            database.SetPattern(pattern);
+            database.table.resize(database.NumStates());
+            database.backing = HugePages::LastBacking();
+            for (auto& value : database.table) value = rng() % 32;
+            databases.push_back(std::move(database));
+        }
+    } else {
+        databases.resize(options.pdb_files.size());
+        for (size_t d = 0; d < databases.size(); ++d) {
+            if (!databases[d].Load(options.pdb_files[d], options.patterns[d], 0)) return 1;
+        }
+    }
+
+    std::cout << "PDB tables on " << HugePages::ToString(databases.front().backing) << "\n";
+    std::cout << "Ranking kernel " << Ranking::ToString(Ranking::Active()) << "\n";
+    std::cout << options.ops << " ops per kernel over " << options.num_states << " random states (seed "
+              << options.seed << ")\n\n";
+
+    Runner runner(options);
+    RunPuzzleKernels(runner, samples);
+    RunBoardKernels(runner, samples);
+    RankingKernels::Run(runner, samples);
+    RunHeuristicKernels(runner, "Manhattan<V1>", ManhattanHeuristic<Variant1>(), samples, moves_v1);
+    RunHeuristicKernels(runner, "Manhattan<V2>", ManhattanHeuristic<Variant2>(), samples, moves_v2);
+    RunHeuristicKernels(runner, "WalkingDistance<V1>", WalkingDistanceHeuristic<Variant1>(&walking_distance), samples, moves_v1);
+    RunHeuristicKernels(runner, "PDB<V1>", PDBHeuristic<Variant1>(&databases), samples, moves_v1);
+    RunExpansionKernels<Variant1>(runner, "PDB<V1>", PDBHeuristic<Variant1>(&databases), samples);
+    // Mod and delta tables only decode variant-1 entries
+    if (std::any_of(databases.begin(), databases.end(),
+                    [](const PatternDatabase& database) { return database.VariantOneOnly(); })) {
+        std::cout << "Skipping PDB<V2>: mod and delta pattern databases are variant 1 only\n";
+    } else {
+        RunExpansionKernels<Variant2>(runner, "PDB<V2>", PDBHeuristic<Variant2>(&databases), samples);
+    }
+
+    std::cout << "\nchecksum " << runner.Checksum() << "\n";
+
+    if (!options.csv_file.empty()) {
+        std::ofstream csv(options.csv_file);
+        csv << "kernel,ns_per_op,allocs_per_op\n";
+        for (const auto& result : runner.Results()) {
+            csv << result.name << ',' << result.ns_per_op << ',' << result.allocs_per_op << '\n';
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,72 @@
+#include "../WalkingDistance.h"
+#include <iostream>
+#include <cassert>
+#include <random>
+#include <array>
+
+namespace Test {
+    std::array<int, 16> GoalTiles() {
+        std::array<int, 16> tiles;
+        for (int i = 0; i < 16; ++i) tiles[i] = i;
+        return tiles;
+    }
+
+    // The incremental update must agree with the from-scratch lookup, and WD
+    // must never exceed the length of the random walk that produced the state
+    void testRandomWalks(const WalkingDistance& wd, int variant) {
+        std::mt19937 gen(variant);
+        for (int walk = 0; walk < 200; ++walk) {
+            Puzzle puzzle(GoalTiles(), variant);
+            WalkingDistance::State state = wd.GetState(puzzle.GetTiles());
+            assert(wd.HeuristicsCost(state, variant) == 0);
+
+            for (int depth = 1; depth <= 60; ++depth) {
+                auto actions = puzzle.GetPossibleActions();
+                std::uniform_int_distribution<> distr(0, actions.size() - 1);
+                Action action = actions[distr(gen)];
+
+                auto [br, bc] = puzzle.GetBlankPosition();
+                state = wd.ApplyAction(state, puzzle.GetTiles(), br, bc, action);
+                puzzle.ApplyAction(action);
+
+                WalkingDistance::State scratch = wd.GetState(puzzle.GetTiles());
+                assert(state.row_index == scratch.row_index);
+                assert(state.col_index == scratch.col_index);
+                assert(wd.HeuristicsCost(state, variant) <= depth);
+            }
+        }
+        std::cout << "Variant " << variant << " random walks passed" << std::endl;
+    }
+
+    void testWalkingDistance() {
+        WalkingDistance wd;
+        wd.Build();
+        std::cout << "Configurations: " << wd.NumConfigurations() << std::endl;
+        assert(wd.NumConfigurations() == 24964);
+
+        testRandomWalks(wd, 1);
+        testRandomWalks(wd, 2);
+
+        // Round trip through the on-disk format
+        assert(wd.SaveToFile("test_wd_table.bin"));
+        WalkingDistance loaded;
+        assert(loaded.LoadFromFile("test_wd_table.bin"));
+        assert(loaded.NumConfigurations() == wd.NumConfigurations());
+
+        std::array<int, 16> korf1 = {14, 13, 15, 7, 11, 12, 9, 5, 6, 0, 2, 1, 4, 8, 10, 3};
+        for (int variant : {1, 2}) {
+            int expected = wd.HeuristicsCost(wd.GetState(korf1), variant);
+            assert(loaded.HeuristicsCost(loaded.GetState(korf1), variant) == expected);
+            std::cout << "korf100 #1 variant " << variant << " WD: " << expected << std::endl;
+        }
+
+        std::cout << "All walking distance tests passed!\n";
+    }
+}
+
+int main() {
+    Test::testWalkingDistance();
+    return 0;
+}
+
+// g++ -std=c++17 test_walking_distance.cpp ../WalkingDistance.cpp ../../Puzzle/Puzzle.cpp -o test_walking_distance
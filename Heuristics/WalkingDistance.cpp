@@ -0,0 +1,293 @@
+#include "WalkingDistance.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <queue>
+#include <stdexcept>
+
+WalkingDistance::WalkingDistance() {
+    if (Puzzle::goal_positions.empty()) {
+        // Constructing any puzzle fills the shared goal table
+        std::array<int, 16> goal;
+        for (int i = 0; i < 16; ++i) goal[i] = i;
+        Puzzle(goal, 1);
+    }
+    for (int tile = 0; tile < 16; ++tile) {
+        const auto& [gr, gc] = Puzzle::goal_positions.at(tile);
+        goal_row[tile] = gr;
+        goal_col[tile] = gc;
+    }
+}
+
+uint64_t WalkingDistance::Pack(const std::array<std::array<int, 4>, 4>& counts, int blank_line) {
+    uint64_t config = 0;
+    for (int line = 0; line < 4; ++line) {
+        for (int k = 0; k < 4; ++k) {
+            config |= static_cast<uint64_t>(counts[line][k]) << (3 * (line * 4 + k));
+        }
+    }
+    config |= static_cast<uint64_t>(blank_line) << 48;
+    return config;
+}
+
+void WalkingDistance::Unpack(uint64_t config, std::array<std::array<int, 4>, 4>& counts, int& blank_line) {
+    for (int line = 0; line < 4; ++line) {
+        for (int k = 0; k < 4; ++k) {
+            counts[line][k] = (config >> (3 * (line * 4 + k))) & 0x7;
+        }
+    }
+    blank_line = (config >> 48) & 0x3;
+}
+
+int WalkingDistance::LookupIndex(const std::array<std::array<int, 4>, 4>& counts, int blank_line) const {
+    auto it = config_index.find(Pack(counts, blank_line));
+    if (it == config_index.end()) {
+        throw std::runtime_error("Walking distance configuration not in table");
+    }
+    return it->second;
+}
+
+void WalkingDistance::EnumerateConfigurations() {
+    configurations.clear();
+    config_index.clear();
+    unit_distance.clear();
+
+    // Goal: every line holds the 4 tiles that belong to it, except the blank's
+    // goal line which holds 3
+    std::array<std::array<int, 4>, 4> goal_counts{};
+    for (int tile = 1; tile < 16; ++tile) {
+        goal_counts[goal_row[tile]][goal_row[tile]]++;
+    }
+    uint64_t goal = Pack(goal_counts, goal_row[0]);
+
+    std::queue<int> q;
+    configurations.push_back(goal);
+    config_index[goal] = 0;
+    unit_distance.push_back(0);
+    q.push(0);
+
+    while (!q.empty()) {
+        int current = q.front();
+        q.pop();
+
+        std::array<std::array<int, 4>, 4> counts;
+        int blank_line;
+        Unpack(configurations[current], counts, blank_line);
+
+        for (int dir = 0; dir < 2; ++dir) {
+            int source_line = (dir == 0) ? blank_line - 1 : blank_line + 1;
+            if (source_line < 0 || source_line > 3) continue;
+
+            for (int k = 0; k < 4; ++k) {
+                if (counts[source_line][k] == 0) continue;
+                counts[source_line][k]--;
+                counts[blank_line][k]++;
+
+                uint64_t next = Pack(counts, source_line);
+                if (config_index.find(next) == config_index.end()) {
+                    int index = configurations.size();
+                    configurations.push_back(next);
+                    config_index[next] = index;
+                    unit_distance.push_back(unit_distance[current] + 1);
+                    q.push(index);
+                }
+
+                counts[blank_line][k]--;
+                counts[source_line][k]++;
+            }
+        }
+    }
+}
+
+void WalkingDistance::ComputeTransitions() {
+    transitions.assign(configurations.size(), {-1, -1, -1, -1, -1, -1, -1, -1});
+
+    for (size_t index = 0; index < configurations.size(); ++index) {
+        std::array<std::array<int, 4>, 4> counts;
+        int blank_line;
+        Unpack(configurations[index], counts, blank_line);
+
+        for (int dir = 0; dir < 2; ++dir) {
+            int source_line = (dir == 0) ? blank_line - 1 : blank_line + 1;
+            if (source_line < 0 || source_line > 3) continue;
+
+            for (int k = 0; k < 4; ++k) {
+                if (counts[source_line][k] == 0) continue;
+                counts[source_line][k]--;
+                counts[blank_line][k]++;
+                transitions[index][dir * 4 + k] = LookupIndex(counts, source_line);
+                counts[blank_line][k]--;
+                counts[source_line][k]++;
+            }
+        }
+    }
+}
+
+void WalkingDistance::ComputeSlideDistances() {
+    // A variant-2 slide moves the blank up to 3 lines in one direction, which in
+    // the WD abstraction is a chain of 1-3 single transitions with any tile class
+    slide_distance.assign(configurations.size(), 0xFF);
+
+    std::queue<int> q;
+    slide_distance[0] = 0;
+    q.push(0);
+
+    while (!q.empty()) {
+        int current = q.front();
+        q.pop();
+
+        for (int dir = 0; dir < 2; ++dir) {
+            std::vector<int> frontier = {current};
+            for (int step = 1; step <= 3 && !frontier.empty(); ++step) {
+                std::vector<int> next_frontier;
+                for (int index : frontier) {
+                    for (int k = 0; k < 4; ++k) {
+                        int next = transitions[index][dir * 4 + k];
+                        if (next == -1) continue;
+                        next_frontier.push_back(next);
+                        if (slide_distance[next] == 0xFF) {
+                            slide_distance[next] = slide_distance[current] + 1;
+                            q.push(next);
+                        }
+                    }
+                }
+                std::sort(next_frontier.begin(), next_frontier.end());
+                next_frontier.erase(std::unique(next_frontier.begin(), next_frontier.end()), next_frontier.end());
+                frontier.swap(next_frontier);
+            }
+        }
+    }
+}
+
+void WalkingDistance::Build() {
+    EnumerateConfigurations();
+    ComputeTransitions();
+    ComputeSlideDistances();
+    std::cout << "Walking distance table built with " << configurations.size() << " configurations" << std::endl;
+}
+
+bool WalkingDistance::SaveToFile(const std::string& filepath) const {
+    std::ofstream file(filepath, std::ios::binary);
+    if (!file) {
+        std::cerr << "Error opening file: " << filepath << std::endl;
+        return false;
+    }
+
+    uint64_t n = configurations.size();
+    file.write(reinterpret_cast<const char*>(&n), sizeof(n));
+    file.write(reinterpret_cast<const char*>(configurations.data()), n * sizeof(uint64_t));
+    file.write(reinterpret_cast<const char*>(unit_distance.data()), n);
+    file.write(reinterpret_cast<const char*>(slide_distance.data()), n);
+    std::cout << "Walking distance table saved to " << filepath << std::endl;
+    return static_cast<bool>(file);
+}
+
+bool WalkingDistance::LoadFromFile(const std::string& filepath) {
+    std::ifstream file(filepath, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+
+    uint64_t n = 0;
+    file.read(reinterpret_cast<char*>(&n), sizeof(n));
+    if (!file || n == 0 || n > (1u << 20)) {
+        std::cerr << "Invalid walking distance table: " << filepath << std::endl;
+        return false;
+    }
+
+    configurations.resize(n);
+    unit_distance.resize(n);
+    slide_distance.resize(n);
+    file.read(reinterpret_cast<char*>(configurations.data()), n * sizeof(uint64_t));
+    file.read(reinterpret_cast<char*>(unit_distance.data()), n);
+    file.read(reinterpret_cast<char*>(slide_distance.data()), n);
+    if (!file) {
+        std::cerr << "Truncated walking distance table: " << filepath << std::endl;
+        configurations.clear();
+        return false;
+    }
+
+    config_index.clear();
+    for (size_t index = 0; index < configurations.size(); ++index) {
+        config_index[configurations[index]] = index;
+    }
+    ComputeTransitions();
+    std::cout << "Walking distance table loaded from " << filepath << std::endl;
+    return true;
+}
+
+void WalkingDistance::LoadOrBuild(const std::string& filepath) {
+    if (LoadFromFile(filepath)) return;
+    Build();
+    SaveToFile(filepath);
+}
+
+bool WalkingDistance::IsBuilt() const {
+    return !transitions.empty();
+}
+
+size_t WalkingDistance::NumConfigurations() const {
+    return configurations.size();
+}
+
+WalkingDistance::State WalkingDistance::GetState(const std::array<int, 16>& tiles) const {
+    std::array<std::array<int, 4>, 4> row_counts{};
+    std::array<std::array<int, 4>, 4> col_counts{};
+    int blank_row = 0, blank_col = 0;
+
+    for (int i = 0; i < 16; ++i) {
+        int tile = tiles[i];
+        if (tile == 0) {
+            blank_row = i / 4;
+            blank_col = i % 4;
+            continue;
+        }
+        row_counts[i / 4][goal_row[tile]]++;
+        col_counts[i % 4][goal_col[tile]]++;
+    }
+    return {LookupIndex(row_counts, blank_row), LookupIndex(col_counts, blank_col)};
+}
+
+WalkingDistance::State WalkingDistance::ApplyAction(
+    const State& state,
+    const std::array<int, 16>& tiles,
+    int blank_row,
+    int blank_col,
+    const Action& action
+) const {
+    State next = state;
+    switch (action.dir) {
+        case Up: {
+            int tile = tiles[(blank_row - 1) * 4 + blank_col];
+            next.row_index = transitions[state.row_index][goal_row[tile]];
+            break;
+        }
+        case Down: {
+            int tile = tiles[(blank_row + 1) * 4 + blank_col];
+            next.row_index = transitions[state.row_index][4 + goal_row[tile]];
+            break;
+        }
+        case Left: {
+            // Tiles cross one column each, nearest to the blank first
+            for (int s = 1; s <= action.steps; ++s) {
+                int tile = tiles[blank_row * 4 + (blank_col - s)];
+                next.col_index = transitions[next.col_index][goal_col[tile]];
+            }
+            break;
+        }
+        case Right: {
+            for (int s = 1; s <= action.steps; ++s) {
+                int tile = tiles[blank_row * 4 + (blank_col + s)];
+                next.col_index = transitions[next.col_index][4 + goal_col[tile]];
+            }
+            break;
+        }
+    }
+    return next;
+}
+
+int WalkingDistance::HeuristicsCost(const State& state, int variant) const {
+    int vertical = unit_distance[state.row_index];
+    int horizontal = (variant == 1) ? unit_distance[state.col_index] : slide_distance[state.col_index];
+    return vertical + horizontal;
+}
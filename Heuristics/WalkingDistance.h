@@ -0,0 +1,74 @@
+#ifndef WALKING_DISTANCE_H
+#define WALKING_DISTANCE_H
+
+#include "../Puzzle/Puzzle.h"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Walking distance (WD) heuristic for the 15-puzzle.
+//
+// A WD configuration records, for every row of the board, how many tiles of
+// each goal row it currently holds, plus the row of the blank. The column view
+// is the same abstraction with goal columns instead of goal rows, so a single
+// table of configurations serves both axes. Distances are computed by BFS from
+// the goal configuration:
+//   - unit_distance:  one tile crosses a line per move (vertical moves of both
+//                     variants, horizontal moves of variant 1)
+//   - slide_distance: up to 3 tiles cross a line in the same direction per move
+//                     (horizontal moves of variant 2)
+class WalkingDistance {
+public:
+    // Table indices of the row and column configurations of one puzzle state
+    struct State {
+        int row_index;
+        int col_index;
+    };
+
+    WalkingDistance();
+
+    void Build();
+    bool LoadFromFile(const std::string& filepath);
+    bool SaveToFile(const std::string& filepath) const;
+    void LoadOrBuild(const std::string& filepath); // Build and cache the table if the file is missing
+    bool IsBuilt() const;
+    size_t NumConfigurations() const;
+
+    // From-scratch lookup of the configurations of a full state
+    State GetState(const std::array<int, 16>& tiles) const;
+
+    // Incremental update: state of the child reached by applying `action`
+    // to the parent `tiles` whose blank is at (blank_row, blank_col)
+    State ApplyAction(const State& state, const std::array<int, 16>& tiles,
+                      int blank_row, int blank_col, const Action& action) const;
+
+    int HeuristicsCost(const State& state, int variant) const;
+
+private:
+    // Packed configuration: 4x4 tile counts (3 bits each) + blank line (2 bits)
+    std::vector<uint64_t> configurations;
+    std::unordered_map<uint64_t, int> config_index;
+
+    // transitions[index][dir * 4 + tile_class]: configuration reached when the
+    // blank moves to line - 1 (dir 0: Up/Left) or line + 1 (dir 1: Down/Right)
+    // swapping with a tile of `tile_class`; -1 if that line holds no such tile
+    std::vector<std::array<int, 8>> transitions;
+
+    std::vector<uint8_t> unit_distance;
+    std::vector<uint8_t> slide_distance;
+
+    std::array<int, 16> goal_row;
+    std::array<int, 16> goal_col;
+
+    static uint64_t Pack(const std::array<std::array<int, 4>, 4>& counts, int blank_line);
+    static void Unpack(uint64_t config, std::array<std::array<int, 4>, 4>& counts, int& blank_line);
+
+    void EnumerateConfigurations();
+    void ComputeTransitions();
+    void ComputeSlideDistances();
+    int LookupIndex(const std::array<std::array<int, 4>, 4>& counts, int blank_line) const;
+};
+
+#endif // WALKING_DISTANCE_H
@@ -0,0 +1,337 @@
+#include "Astar.h"
+#include "../Search/TranspositionTable.h"
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+    // A popped state is evaluated from scratch; mod databases can only do
+    // that by descending to the goal, which is far too slow per expansion
+    template <typename Heuristic>
+    bool EvaluatesFromScratch(const Heuristic&) { return true; }
+
+    template <typename Variant>
+    bool EvaluatesFromScratch(const PDBHeuristic<Variant>& heuristic) { return !heuristic.HasMod(); }
+}
+
+template <typename Variant, typename Heuristic>
+Astar<Variant, Heuristic>::Astar(const Heuristic& heuristic, size_t memory_mb, WorkerCounters* counters)
+    : heuristic(heuristic), memory_bytes(memory_mb << 20), counters(counters), num_entries(0), shift(0),
+      open_entries(0), layers(0), nodes_expanded(0), nodes_generated(0), elapsed(0.0),
+      status(SolveStatus::Exhausted), lower_bound(0) {
+    if (!EvaluatesFromScratch(heuristic)) {
+        throw std::invalid_argument("A* cannot use mod pattern databases");
+    }
+}
+
+template <typename Variant, typename Heuristic>
+size_t Astar<Variant, Heuristic>::Find(uint64_t key) const {
+    const size_t mask = keys.size() - 1;
+    size_t slot = static_cast<size_t>((key * 0x9E3779B97F4A7C15ULL) >> shift);
+    while (keys[slot] != kEmpty && keys[slot] != key) slot = (slot + 1) & mask;
+    return slot;
+}
+
+template <typename Variant, typename Heuristic>
+void Astar<Variant, Heuristic>::Prefetch(uint64_t key) const {
+    const size_t slot = static_cast<size_t>((key * 0x9E3779B97F4A7C15ULL) >> shift);
+    __builtin_prefetch(&keys[slot]);
+    __builtin_prefetch(&info[slot]);
+}
+
+// The old table is freed once its entries are moved, so the process briefly
+// holds half as much again as the new table
+template <typename Variant, typename Heuristic>
+bool Astar<Variant, Heuristic>::Grow() {
+    const size_t slots = keys.empty() ? kInitialSlots : keys.size() * 2;
+    if (slots * (sizeof(uint64_t) + sizeof(uint16_t)) + open_entries * sizeof(uint64_t) > memory_bytes) return false;
+
+    HugePageVector<uint64_t> old_keys(slots, kEmpty);
+    HugePageVector<uint16_t> old_info(slots, 0);
+    old_keys.swap(keys);
+    old_info.swap(info);
+    shift = 64 - __builtin_ctzll(slots);
+    for (size_t i = 0; i < old_keys.size(); ++i) {
+        if (old_keys[i] == kEmpty) continue;
+        const size_t slot = Find(old_keys[i]);
+        keys[slot] = old_keys[i];
+        info[slot] = old_info[i];
+    }
+    return true;
+}
+
+template <typename Variant, typename Heuristic>
+void Astar<Variant, Heuristic>::Push(int f, int g, uint64_t key) {
+    const size_t index = static_cast<size_t>(f) * kMaxCost + g;
+    if (index >= buckets.size()) buckets.resize((static_cast<size_t>(f) + 1) * kMaxCost);
+    buckets[index].push_back(key);
+    open_entries++;
+}
+
+// Follows the stored moves back from board to the root
+template <typename Variant, typename Heuristic>
+std::vector<Action> Astar<Variant, Heuristic>::PathTo(typename Variant::Board board) const {
+    std::vector<Action> path;
+    while (true) {
+        const int code = info[Find(TranspositionTable::PackState(board.tiles))] >> 8;
+        if (code == 0) break;
+        const Action action{static_cast<Direction>(code >> 2), code & 3};
+        const int step = (action.dir == Left) ? -1 : (action.dir == Right) ? 1
+                       : (action.dir == Up) ? -Variant::kCols : Variant::kCols;
+        const MoveList& moves = Variant::Moves(board.blank - step * action.steps);
+        for (int i = 0; i < moves.size; ++i) {
+            if (moves.moves[i].action.dir == action.dir && moves.moves[i].action.steps == action.steps) {
+                board.Undo(moves.moves[i]);
+                break;
+            }
+        }
+        path.push_back(action);
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+template <typename Variant, typename Heuristic>
+void Astar<Variant, Heuristic>::Release() {
+    HugePageVector<uint64_t>().swap(keys);
+    HugePageVector<uint16_t>().swap(info);
+    std::vector<std::vector<uint64_t>>().swap(buckets);
+    num_entries = 0;
+    open_entries = 0;
+}
+
+template <typename Variant, typename Heuristic>
+Checkpoint Astar<Variant, Heuristic>::Handoff() const {
+    Checkpoint checkpoint;
+    checkpoint.tiles = root_tiles;
+    checkpoint.solved = (status == SolveStatus::Solved);
+    checkpoint.bound = lower_bound;
+    checkpoint.iterations = layers;
+    checkpoint.nodes_expanded = nodes_expanded;
+    checkpoint.nodes_generated = nodes_generated;
+    checkpoint.elapsed = elapsed;
+    return checkpoint;
+}
+
+template <typename Variant, typename Heuristic>
+std::tuple<std::vector<Action>, int, double, long long, long long, typename Variant::Puzzle> Astar<Variant, Heuristic>::Solve(
+    Puzzle& puzzle, IterationCallback callback, int core_num, std::ofstream& outfile, const SearchLimits& limits) {
+    const auto start = std::chrono::high_resolution_clock::now();
+    auto seconds = [&start]() {
+        std::chrono::duration<double> time = std::chrono::high_resolution_clock::now() - start;
+        return time.count();
+    };
+
+    typename Variant::Board board;
+    board.tiles = puzzle.GetTiles();
+    const auto [blank_row, blank_col] = puzzle.GetBlankPosition();
+    board.blank = blank_row * Variant::kCols + blank_col;
+    root_tiles.assign(board.tiles.begin(), board.tiles.end());
+
+    Release();
+    layers = 0;
+    nodes_expanded = 0;
+    nodes_generated = 0;
+    int layer = heuristic.Value(heuristic.Root(board));
+    lower_bound = layer;
+
+    const auto deadline = std::chrono::steady_clock::now() +
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(limits.max_seconds));
+    long long check_at = limits.Unlimited() ? std::numeric_limits<long long>::max() : 0;
+    auto limit_reached = [&]() {
+        if (limits.max_nodes > 0 && nodes_expanded >= limits.max_nodes) {
+            status = SolveStatus::NodeLimit;
+            return true;
+        }
+        if (limits.cancel && limits.cancel->IsCancelled()) {
+            status = SolveStatus::Cancelled;
+            return true;
+        }
+        if (limits.max_seconds > 0.0 && std::chrono::steady_clock::now() >= deadline) {
+            status = SolveStatus::TimeLimit;
+            return true;
+        }
+        check_at = nodes_expanded + SearchLimits::kCheckInterval;
+        if (limits.max_nodes > 0) check_at = std::min(check_at, limits.max_nodes);
+        return false;
+    };
+
+    IterationStats stats;
+    stats.iteration = 1;
+    stats.bound = layer;
+    auto layer_start = std::chrono::high_resolution_clock::now();
+    auto finish_layer = [&](bool solved) {
+        std::chrono::duration<double> layer_time = std::chrono::high_resolution_clock::now() - layer_start;
+        stats.wall_time = layer_time.count();
+        stats.solved = solved;
+        callback(core_num, stats, outfile);
+        ++layers;
+    };
+    auto solved = [&](const typename Variant::Board& goal) {
+        std::vector<Action> path = PathTo(goal);
+        finish_layer(true);
+        status = SolveStatus::Solved;
+        lower_bound = static_cast<int>(path.size());
+        elapsed = seconds();
+        Release();
+        for (const auto& action : path) puzzle.ApplyAction(action);
+        return std::make_tuple(path, lower_bound, elapsed, nodes_expanded, nodes_generated, puzzle);
+    };
+    auto stopped = [&](SolveStatus reason) {
+        status = reason;
+        lower_bound = layer;
+        elapsed = seconds();
+        Release();
+        return std::make_tuple(std::vector<Action>(), -1, elapsed, nodes_expanded, nodes_generated, puzzle);
+    };
+
+    if (counters) counters->NewIteration(layer);
+    if (!Grow()) return stopped(SolveStatus::MemoryLimit);
+    const uint64_t root_key = TranspositionTable::PackState(board.tiles);
+    const size_t root_slot = Find(root_key);
+    keys[root_slot] = root_key;
+    info[root_slot] = 0;
+    num_entries = 1;
+    if (board.IsGoal()) return solved(board);
+    Push(layer, 0, root_key);
+
+    auto bucket = [&](int f, int depth) -> std::vector<uint64_t>* {
+        const size_t index = static_cast<size_t>(f) * kMaxCost + depth;
+        return index < buckets.size() ? &buckets[index] : nullptr;
+    };
+    auto has_entries = [&](int f) {
+        for (int depth = 0; depth < kMaxCost; ++depth) {
+            if (bucket(f, depth) && !bucket(f, depth)->empty()) return true;
+        }
+        return false;
+    };
+
+    const Move* batch_moves[Variant::kMaxChildren] = {};
+    HeuristicState batch_states[Variant::kMaxChildren];
+    uint64_t batch_keys[Variant::kMaxChildren];
+    int g = 0;                                   // Highest g that may hold entries of this layer
+    while (true) {
+        // Pop the deepest entry of the lowest layer
+        std::vector<uint64_t>* entries = bucket(layer, g);
+        while (!entries || entries->empty()) {
+            if (--g >= 0) {
+                entries = bucket(layer, g);
+                continue;
+            }
+            finish_layer(false);
+            // Skip to the lowest layer holding entries (re-pushed nodes)
+            do {
+                ++layer;
+            } while (open_entries > 0 && layer < kMaxCost && !has_entries(layer));
+            if (open_entries == 0 || layer >= kMaxCost) {
+                status = SolveStatus::Exhausted;
+                lower_bound = layer;
+                elapsed = seconds();
+                Release();
+                return std::make_tuple(std::vector<Action>(), -1, elapsed, nodes_expanded, nodes_generated, puzzle);
+            }
+            lower_bound = layer;
+            if (counters) counters->NewIteration(layer);
+            stats = IterationStats();
+            stats.iteration = layers + 1;
+            stats.bound = layer;
+            layer_start = std::chrono::high_resolution_clock::now();
+            g = kMaxCost - 1;
+            entries = bucket(layer, g);
+        }
+        const uint64_t key = entries->back();
+        entries->pop_back();
+        open_entries--;
+        if (!entries->empty()) Prefetch(entries->back());
+        const uint16_t entry = info[Find(key)];
+        if ((entry & 0xFF) != g) continue;   // Reached again with a lower g since
+        if (nodes_expanded >= check_at && limit_reached()) return stopped(status);
+
+        for (int p = 0; p < Variant::kCells; ++p) {
+            board.tiles[p] = static_cast<int>(key >> (4 * p) & 0xF);
+            if (board.tiles[p] == 0) board.blank = p;
+        }
+        const HeuristicState h_state = heuristic.Root(board);
+        const int h = heuristic.Value(h_state);
+
+        // The reverse move only leads back (or, for a slide, to a sibling of
+        // the parent reached one move later)
+        const int parent_code = entry >> 8;
+        int batch_size = 0;
+        const MoveList& moves = Variant::Moves(board.blank);
+        for (int i = 0; i < moves.size; ++i) {
+            if (parent_code != 0 && moves.moves[i].action.dir == Opposite(static_cast<Direction>(parent_code >> 2))) continue;
+            batch_moves[batch_size++] = &moves.moves[i];
+        }
+        stats.heuristic_evals += batch_size;
+        heuristic.PrepareChildren(h_state, board, batch_moves, batch_size, batch_states);
+
+        // Children of this layer first, with their table slots prefetched
+        int next_f = kMaxCost;
+        int num_stored = 0;
+        for (int i = 0; i < batch_size; ++i) {
+            const Move& move = *batch_moves[i];
+            heuristic.FinishChild(batch_states[i]);
+            const int cost = Variant::Cost(move);
+            int child_h = heuristic.Value(batch_states[i]);
+            if (!Heuristic::kConsistent) child_h = std::max(child_h, h - cost);
+            const int f = g + cost + child_h;
+            if (f > layer) {
+                // Left for a later expansion of this node
+                next_f = std::min(next_f, f);
+                continue;
+            }
+            board.Apply(move);
+            batch_keys[num_stored] = TranspositionTable::PackState(board.tiles);
+            Prefetch(batch_keys[num_stored]);
+            batch_moves[num_stored++] = &move;
+            board.Undo(move);
+        }
+
+        for (int i = 0; i < num_stored; ++i) {
+            const Move& move = *batch_moves[i];
+            const int cost = Variant::Cost(move);
+            const uint64_t child_key = batch_keys[i];
+            board.Apply(move);
+            size_t slot = Find(child_key);
+            if (keys[slot] == child_key && (info[slot] & 0xFF) <= g + cost) {
+                board.Undo(move);
+                continue;
+            }
+            if (keys[slot] != child_key) {
+                if ((num_entries + 1) * 4 > keys.size() * 3) {
+                    if (!Grow()) return stopped(SolveStatus::MemoryLimit);
+                    slot = Find(child_key);
+                }
+                keys[slot] = child_key;
+                num_entries++;
+            }
+            info[slot] = Info(g + cost, move.action);
+            nodes_generated++;
+            stats.nodes_generated++;
+            // f <= layer <= C*, so a goal found here is optimal
+            if (board.IsGoal()) return solved(board);
+            Push(layer, g + cost, child_key);
+            board.Undo(move);
+        }
+        if (next_f < kMaxCost) Push(next_f, g, key);
+        nodes_expanded++;
+        stats.nodes_expanded++;
+        if (counters && nodes_expanded % WorkerCounters::kPublishInterval == 0) {
+            counters->Publish(nodes_expanded, nodes_generated, g);
+        }
+        if (MemoryUsed() > memory_bytes) return stopped(SolveStatus::MemoryLimit);
+
+        // Children were pushed one deeper
+        g = std::min(g + 1, kMaxCost - 1);
+    }
+}
+
+// The 15-puzzle combinations of IDAstar
+template class Astar<Variant1, ManhattanHeuristic<Variant1>>;
+template class Astar<Variant1, WalkingDistanceHeuristic<Variant1>>;
+template class Astar<Variant1, PDBHeuristic<Variant1>>;
+template class Astar<Variant2, ManhattanHeuristic<Variant2>>;
+template class Astar<Variant2, WalkingDistanceHeuristic<Variant2>>;
+template class Astar<Variant2, PDBHeuristic<Variant2>>;
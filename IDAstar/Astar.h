@@ -0,0 +1,112 @@
+#ifndef ASTAR_H
+#define ASTAR_H
+
+#include "Checkpoint.h"
+#include "Heuristic.h"
+#include "IDAstar.h"
+#include "Variant.h"
+#include "../Puzzle/Puzzle.h"
+#include "../Search/HugePages.h"
+#include "../Search/IterationStats.h"
+#include "../Search/SearchLimits.h"
+#include "../Search/Telemetry.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <tuple>
+#include <vector>
+
+// Memory-bounded A* over the same variants and heuristics as IDAstar, for
+// instances where IDA*'s re-expansion of every earlier iteration dominates
+// (variant 2 above all). Each state is kept once, as the 64-bit packed board
+// of TranspositionTable::PackState, so it runs on the 15-puzzle only.
+//
+// The search is partial-expansion A*: a node popped at f-layer F stores only
+// the children with f <= F and goes back to the open list at the smallest f
+// of the rest. Children never enter the tables before their layer is
+// reached, which keeps both at roughly the nodes with f <= C*. Every stored
+// child thus belongs to the current layer, and the goal can be accepted as
+// soon as it is generated.
+//
+//   open list     one bucket per (f, g) of packed states; the lowest f is
+//                 expanded first, the highest g within it (deepest first)
+//   closed table  open addressing over packed states, with the best g and
+//                 the move that reached it for rebuilding the path; it
+//                 doubles at 3/4 load
+//
+// Stale open entries (their state was reached again with a lower g) are
+// skipped when popped. States are reopened when a shorter path turns up,
+// which the inconsistent PDB heuristics need.
+//
+// A solve that would grow the tables past the memory cap stops with
+// SolveStatus::MemoryLimit. LowerBound() then holds the layer being
+// expanded, and Handoff() returns the checkpoint that lets IDAstar continue
+// from that bound.
+template <typename Variant, typename Heuristic>
+class Astar {
+    static_assert(Variant::kCells == 16, "Astar packs 15-puzzle states into 64 bits");
+
+public:
+    using Puzzle = typename Variant::Puzzle;
+
+    static const size_t kDefaultMemoryMB = 1024;
+
+    explicit Astar(const Heuristic& heuristic, size_t memory_mb = kDefaultMemoryMB, WorkerCounters* counters = nullptr);
+
+    // Same result as IDAstar::Solve; the callback gets one IterationStats
+    // per finished f-layer
+    std::tuple<std::vector<Action>, int, double, long long, long long, Puzzle> Solve(Puzzle& puzzle, IterationCallback, int, std::ofstream&,
+                                                                                     const SearchLimits& limits = SearchLimits());
+
+    SolveStatus Status() const { return status; }
+    // Optimal solution length once solved; otherwise the f-layer being
+    // expanded, since every smaller layer is exhausted
+    int LowerBound() const { return lower_bound; }
+    // Resume point for IDAstar after a stop: the lower bound, the layers as
+    // iterations and this solve's node counts and time
+    Checkpoint Handoff() const;
+
+private:
+    using HeuristicState = typename Heuristic::State;
+
+    static const int kMaxCost = 256;                 // g and f fit the closed table's byte
+    static const size_t kInitialSlots = 1 << 16;
+    static const uint64_t kEmpty = 0;                // No permutation packs to 0
+
+    // Closed table entry: g in the low byte, the move into the state in the
+    // high byte as (dir << 2 | steps); 0 for the root
+    static uint16_t Info(int g, const Action& action) {
+        return static_cast<uint16_t>(g | (action.dir << 2 | action.steps) << 8);
+    }
+
+    const Heuristic& heuristic;              // Shared read-only across solver threads
+    const size_t memory_bytes;               // Cap on the closed table plus the open list
+    WorkerCounters* counters;                // Optional progress counters sampled by the telemetry reporter
+
+    HugePageVector<uint64_t> keys;              // Closed table: packed states, kEmpty for free slots
+    HugePageVector<uint16_t> info;
+    size_t num_entries;
+    int shift;                               // 64 - log2(slots)
+
+    std::vector<std::vector<uint64_t>> buckets;  // Open list, index f * kMaxCost + g
+    size_t open_entries;
+
+    std::vector<int> root_tiles;
+    int layers;                              // Finished f-layers
+    long long nodes_expanded;
+    long long nodes_generated;
+    double elapsed;
+    SolveStatus status;
+    int lower_bound;
+
+    size_t Find(uint64_t key) const;         // Slot of key, or the free slot it would take
+    void Prefetch(uint64_t key) const;       // Starts loading the lines Find(key) reads first
+    bool Grow();                             // false: a larger table would break the cap
+    size_t MemoryUsed() const { return keys.size() * (sizeof(uint64_t) + sizeof(uint16_t)) + open_entries * sizeof(uint64_t); }
+    void Push(int f, int g, uint64_t key);
+    std::vector<Action> PathTo(typename Variant::Board board) const;
+    void Release();
+};
+
+#endif // ASTAR_H
@@ -0,0 +1,598 @@
+#include "Astar.h"
+#include "IDAstar.h"
+#include "InstanceStream.h"
+#include "../Search/Numa.h"
+#include "../Search/PerfCounters.h"
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <algorithm>
+#include <array>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <csignal>
+#include <iomanip> // For std::setprecision
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+// Set by the first SIGINT/SIGTERM: running solves stop and report their lower
+// bound, queued instances are dropped. A second signal terminates at once.
+CancellationToken cancel_token;
+
+extern "C" void HandleStopSignal(int signal) {
+    cancel_token.Cancel();
+    std::signal(signal, SIG_DFL);
+}
+
+struct Options {
+    std::vector<std::string> inputs;               // Instance files, "-" for stdin
+    int num_threads = 0;                           // 0: one per hardware thread
+    std::string output_dir = "../Data";
+    bool write_results = true;                     // One result_Puzzle_<id>.txt per instance
+    int variant = 1;
+    std::string heuristic = "wd";                  // md, wd or pdb
+    std::vector<std::string> pdb_files;
+    std::vector<std::vector<int>> patterns;
+    std::string wd_file = "../Heuristics/wd_table.bin";
+    std::string fsm_file;                          // Default ../Search/fsm_v<variant>.bin, "none" disables
+    int tt_size_mb = 0;
+    double report_interval = 5.0;
+    std::string stats_file;                        // Default <output_dir>/iteration_stats_<solver>.csv
+    std::string checkpoint_dir;                    // Empty: no checkpoints
+    long long max_nodes = 0;                       // Per instance, 0: unlimited
+    double max_time = 0.0;                         // Seconds per instance, 0: unlimited
+    bool perf = false;                             // Hardware counters per instance
+    std::string engine = "idastar";                // idastar or astar
+    size_t astar_memory_mb = 1024;                 // Per worker, then IDA* takes over
+    Numa::Policy numa = Numa::Policy::Off;         // PDB placement and worker binding
+};
+
+void PrintUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [options] [instance_file|-]...\n"
+              << "  Instance files hold one puzzle per line, \"id t0 ... t15\" (korf100 format) or \"t0 ... t15\";\n"
+              << "  \"-\" reads stdin. Default: ../Data/korf100.txt\n"
+              << "  --threads <n>                  Solver threads (default: hardware threads)\n"
+              << "  --output-dir <dir>             Result, summary, telemetry and statistics files (default ../Data)\n"
+              << "  --no-results                   Skip the per-instance result files (summary only)\n"
+              << "  --variant 1|2                  Puzzle variant (default 1)\n"
+              << "  --heuristic md|wd|pdb          Manhattan, max(Manhattan, walking distance) or PDBs (default wd)\n"
+              << "  --pdb <file> <pattern>         Pattern database and its tiles, e.g. \"{1,2,3,4,5,6,7}\"; repeat per PDB\n"
+              << "  --wd <file>                    Walking distance table (default ../Heuristics/wd_table.bin)\n"
+              << "  --fsm <file>|none              Move pruning FSM (default ../Search/fsm_v<variant>.bin)\n"
+              << "  --tt <mb>                      Shared transposition table size (default 0, disabled)\n"
+              << "  --report <seconds>             Progress report interval (default 5, 0 disables)\n"
+              << "  --stats <file>                 Per-iteration statistics, .csv or .jsonl\n"
+              << "  --checkpoint-dir <dir>         Save per-instance progress and resume from it on the next run\n"
+              << "  --max-nodes <n>                Expanded node budget per instance (default 0, unlimited)\n"
+              << "  --max-time <seconds>           Wall clock budget per instance (default 0, unlimited)\n"
+              << "  --perf                         Hardware counters per instance (Linux perf_event_open)\n"
+              << "  --engine idastar|astar         Search engine (default idastar); A* hands over to IDA* at its memory cap\n"
+              << "  --astar-memory <mb>            A* closed table and open list per worker (default 1024)\n"
+              << "  --huge-pages off|thp|explicit  PDB memory: 4 KB pages, transparent or reserved 2 MB pages (default thp)\n"
+              << "  --numa off|replicate|interleave  PDB copy per NUMA node with node-bound workers, or one interleaved copy\n";
+}
+
+std::vector<int> ParsePattern(const std::string& pattern_str) {
+    std::vector<int> pattern;
+    std::string cleaned = pattern_str;
+    if (!cleaned.empty() && cleaned.front() == '{') cleaned = cleaned.substr(1, cleaned.size() - 2); // Remove '{' and '}'
+    std::istringstream iss(cleaned);
+    std::string token;
+    while (std::getline(iss, token, ',')) {
+        pattern.push_back(std::stoi(token));
+    }
+    return pattern;
+}
+
+void ParseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) throw std::invalid_argument("missing value for " + arg);
+            return argv[++i];
+        };
+        if (arg == "--threads") {
+            options.num_threads = std::stoi(value());
+        } else if (arg == "--output-dir") {
+            options.output_dir = value();
+        } else if (arg == "--no-results") {
+            options.write_results = false;
+        } else if (arg == "--variant") {
+            options.variant = std::stoi(value());
+        } else if (arg == "--heuristic") {
+            options.heuristic = value();
+        } else if (arg == "--pdb") {
+            options.pdb_files.push_back(value());
+            options.patterns.push_back(ParsePattern(value()));
+        } else if (arg == "--wd") {
+            options.wd_file = value();
+        } else if (arg == "--fsm") {
+            options.fsm_file = value();
+        } else if (arg == "--tt") {
+            options.tt_size_mb = std::stoi(value());
+        } else if (arg == "--report") {
+            options.report_interval = std::stod(value());
+        } else if (arg == "--stats") {
+            options.stats_file = value();
+        } else if (arg == "--checkpoint-dir") {
+            options.checkpoint_dir = value();
+        } else if (arg == "--max-nodes") {
+            options.max_nodes = std::stoll(value());
+        } else if (arg == "--max-time") {
+            options.max_time = std::stod(value());
+        } else if (arg == "--perf") {
+            options.perf = true;
+        } else if (arg == "--engine") {
+            options.engine = value();
+        } else if (arg == "--astar-memory") {
+            options.astar_memory_mb = std::stoul(value());
+        } else if (arg == "--numa") {
+            if (!Numa::ParsePolicy(value(), options.numa)) throw std::invalid_argument("numa must be off, replicate or interleave");
+        } else if (arg == "--huge-pages") {
+            HugePages::Policy policy;
+            if (!HugePages::ParsePolicy(value(), policy)) throw std::invalid_argument("huge pages must be off, thp or explicit");
+            HugePages::SetPolicy(policy);
+        } else if (arg.size() > 1 && arg[0] == '-' && arg != "-") {
+            throw std::invalid_argument("unknown option " + arg);
+        } else {
+            options.inputs.push_back(arg);
+        }
+    }
+    if (options.variant != 1 && options.variant != 2) {
+        throw std::invalid_argument("variant must be 1 or 2");
+    }
+    if (options.heuristic != "md" && options.heuristic != "wd" && options.heuristic != "pdb") {
+        throw std::invalid_argument("heuristic must be md, wd or pdb");
+    }
+    if (options.engine != "idastar" && options.engine != "astar") {
+        throw std::invalid_argument("engine must be idastar or astar");
+    }
+    if (options.heuristic == "pdb" && options.pdb_files.empty()) {
+        throw std::invalid_argument("the pdb heuristic needs at least one --pdb <file> <pattern>");
+    }
+    if (options.inputs.empty()) {
+        options.inputs.push_back("../Data/korf100.txt");
+    }
+    if (options.num_threads <= 0) {
+        options.num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    if (options.fsm_file.empty()) {
+        options.fsm_file = "../Search/fsm_v" + std::to_string(options.variant) + ".bin";
+    }
+}
+
+// Local PrintState function (copy of the printing logic)
+void PrintStateToFile(const Puzzle& puzzle, std::ostream& os) {
+    const auto& state = puzzle.GetTiles(); // Use the getter!
+    for (int i = 0; i < 16; ++i) {
+        os << state[i] << " ";
+        if ((i + 1) % 4 == 0) {
+            os << "\n";
+        }
+    }
+}
+
+// Shared resources of one run
+struct SolverContext {
+    std::string solver_name;             // Tags statistics and telemetry, e.g. v1_wd
+    int variant;
+    std::string output_dir;
+    bool write_results;
+    const MovePruningFSM* move_pruning;
+    TranspositionTable* transposition_table;
+    StatsSink* stats_sink;
+    SearchLimits limits;                 // Per instance, shares cancel_token
+    std::string checkpoint_dir;          // Empty: no checkpoints
+    std::string checkpoint_solver;       // Search configuration a saved DFS position belongs to
+    std::ofstream summary;               // One line per solved instance
+    std::mutex summary_mutex;
+    bool perf;                           // Hardware counters per instance
+    bool astar;                          // A* first, IDA* past its memory cap
+    size_t astar_memory_mb;
+    std::ofstream perf_csv;              // One line per instance, written under summary_mutex
+    PerfSample perf_total = PerfSample::Zero();
+    long long perf_nodes = 0;
+    std::atomic<long long> num_solved{0};
+    std::atomic<long long> num_stopped{0};
+};
+
+// One summary line per instance; lower_bound equals the solution length for
+// solved instances
+template <typename Result>
+void WriteSummary(SolverContext& context, int puzzle_num, SolveStatus status, int lower_bound, const Result& result) {
+    std::ostringstream line;
+    line << puzzle_num << ',' << ToString(status) << ','
+         << (status == SolveStatus::Solved ? std::get<1>(result) : -1) << ',' << lower_bound << ','
+         << std::get<3>(result) << ',' << std::get<4>(result) << ','
+         << std::fixed << std::setprecision(6) << std::get<2>(result) << '\n';
+    std::lock_guard<std::mutex> lock(context.summary_mutex);
+    context.summary << line.str() << std::flush;
+}
+
+// Counters of one solve next to its node count; the run total is printed at
+// the end
+void WritePerf(SolverContext& context, int puzzle_num, SolveStatus status, long long nodes_expanded,
+               const PerfSample& sample) {
+    std::ostringstream line;
+    line << puzzle_num << ',' << ToString(status) << ',' << nodes_expanded << ',';
+    sample.WriteCsv(line, nodes_expanded);
+    std::lock_guard<std::mutex> lock(context.summary_mutex);
+    context.perf_csv << line.str() << '\n' << std::flush;
+    context.perf_total += sample;
+    context.perf_nodes += nodes_expanded;
+}
+
+// With astar, a fresh instance is solved by A* first; past its memory cap
+// IDA* continues from the bound A* proved. A resumed instance goes straight
+// to IDA*, which the checkpoint belongs to.
+template <typename Variant, typename Heuristic>
+void SolvePuzzleAndWrite(IDAstar<Variant, Heuristic>& solver, Astar<Variant, Heuristic>* astar, const Instance& instance,
+                         int core_num, SolverContext& context, WorkerCounters& counters, PerfCounters* perf) {
+    const int puzzle_num = instance.id;
+    Puzzle puzzle(instance.tiles, context.variant);
+
+    // Progress of an earlier run of this instance
+    Checkpoint resume;
+    bool resuming = false;
+    std::string checkpoint_path;
+    if (!context.checkpoint_dir.empty()) {
+        checkpoint_path = context.checkpoint_dir + "/checkpoint_Puzzle_" + std::to_string(puzzle_num) + ".txt";
+        resuming = resume.Load(checkpoint_path);
+        if (resuming && !std::equal(resume.tiles.begin(), resume.tiles.end(), instance.tiles.begin(), instance.tiles.end())) {
+            std::cerr << checkpoint_path << ": different initial state, starting over\n";
+            resuming = false;
+        }
+    }
+    if (resuming && resume.solved) {
+        WriteSummary(context, puzzle_num, SolveStatus::Solved, resume.bound,
+                     std::make_tuple(std::vector<Action>(), resume.bound, resume.elapsed,
+                                     resume.nodes_expanded, resume.nodes_generated, puzzle));
+        context.num_solved++;
+        return;
+    }
+    if (resuming && resume.solver != context.checkpoint_solver) {
+        // Finished bounds hold for any admissible search; the DFS position does not
+        resume.path.clear();
+        resume.frontier_min = Checkpoint::kNoFrontier;
+    }
+
+    // Without result files the solver writes into a closed stream (no-op).
+    // A resumed instance appends to the result file of the earlier run.
+    std::ofstream outfile;
+    if (context.write_results) {
+        outfile.open(context.output_dir + "/result_Puzzle_" + std::to_string(puzzle_num) + ".txt",
+                     resuming ? std::ios::app : std::ios::out);
+        if (!outfile.is_open()) {
+            std::cerr << "Failed to open result_Puzzle_" << puzzle_num << ".txt for writing\n";
+        }
+    }
+
+    const bool astar_first = astar && !resuming;
+    const char* engine = astar_first ? "A*" : "IDA*";
+    if (resuming) {
+        outfile << "Resuming at bound " << resume.bound << (resume.HasPosition() ? " (saved position)" : "") << "\n";
+    } else {
+        outfile << engine << " working to solve Puzzle " << puzzle_num << ":\n";
+        outfile << "################################";
+        outfile << "\nInitial State:\n===============\n";
+        PrintStateToFile(puzzle, outfile); // Use the local function
+        outfile << "\n";
+    }
+
+    // Live progress goes through the telemetry reporter; iterations are
+    // logged to the result file and the statistics sink
+    counters.Begin(core_num, puzzle_num);
+    if (perf) perf->Start();
+    auto log_iteration = [puzzle_num, &context](int core_num, const IterationStats& stats, std::ofstream &outfile) {
+        outfile << "Core_" << core_num << ":\tIteration with bound " << stats.bound << "; "
+                << stats.nodes_expanded << " expanded, " << stats.nodes_generated << " generated\n";
+        context.stats_sink->Write(context.solver_name, puzzle_num, stats);
+    };
+    CheckpointCallback save_checkpoint;
+    if (!checkpoint_path.empty()) {
+        save_checkpoint = [puzzle_num, &context, &checkpoint_path](const Checkpoint& progress) {
+            Checkpoint saved = progress;
+            saved.puzzle_num = puzzle_num;
+            saved.solver = context.checkpoint_solver;
+            if (!saved.Save(checkpoint_path)) {
+                std::cerr << "Failed to write " << checkpoint_path << "\n";
+            }
+        };
+    }
+    auto result = astar_first ? astar->Solve(puzzle, log_iteration, core_num, outfile, context.limits)
+                              : solver.Solve(puzzle, log_iteration, core_num, outfile, context.limits,
+                                             resuming ? &resume : nullptr, save_checkpoint);
+    SolveStatus status = astar_first ? astar->Status() : solver.Status();
+    int lower_bound = astar_first ? astar->LowerBound() : solver.LowerBound();
+    if (astar_first) {
+        // A* keeps no position; a restarted run continues with IDA* from its bound
+        const Checkpoint handoff = astar->Handoff();
+        if (save_checkpoint) save_checkpoint(handoff);
+        if (status == SolveStatus::MemoryLimit) {
+            outfile << "A*: memory cap reached at bound " << lower_bound << " after " << handoff.nodes_expanded
+                    << " expanded; continuing with IDA*\n";
+            engine = "IDA*";
+            result = solver.Solve(puzzle, log_iteration, core_num, outfile,
+                                  context.limits.Remaining(handoff.nodes_expanded, handoff.elapsed), &handoff,
+                                  save_checkpoint);
+            status = solver.Status();
+            lower_bound = solver.LowerBound();
+        }
+    }
+    counters.End();
+    if (perf) {
+        // A resumed solve reports the nodes of all its runs; count this run only
+        WritePerf(context, puzzle_num, status, std::get<3>(result) - (resuming ? resume.nodes_expanded : 0),
+                  perf->Stop());
+    }
+
+    if (status != SolveStatus::Solved) {
+        outfile << engine << ": stopped (" << ToString(status) << ") after " << std::fixed << std::setprecision(2)
+                << std::get<2>(result) << "s; " << std::get<3>(result) << " expanded; " << std::get<4>(result)
+                << " generated; lower bound " << lower_bound << "\n";
+        outfile.close();
+        WriteSummary(context, puzzle_num, status, lower_bound, result);
+        context.num_stopped++;
+        return;
+    }
+
+    outfile << engine << ": " << std::fixed << std::setprecision(2) << std::get<2>(result) << "s elapsed; " // Time (double)
+        << std::get<3>(result) << " expanded; "                                      // Expanded nodes (long long)
+        << std::get<4>(result) << " generated; "                                     // Generated nodes (long long)
+        << "solution length " << std::get<1>(result) << "\n";
+
+    outfile << "\nGoal State:\n===============\n";
+    PrintStateToFile(std::get<5>(result), outfile); // Use the local function
+    outfile << "\n";                    // Moves (int)
+
+    outfile << "\nPath: \n===============\n";
+    for (const auto& action : std::get<0>(result)) {
+        std::string dir_str;
+        switch (action.dir) {
+            case Left: dir_str = "Left"; break;
+            case Right: dir_str = "Right"; break;
+            case Up: dir_str = "Up"; break;
+            case Down: dir_str = "Down"; break;
+        }
+        outfile << "Direction: " << dir_str << ", Steps: " << action.steps << "\n";
+    }
+    outfile.close();
+
+    WriteSummary(context, puzzle_num, status, std::get<1>(result), result);
+    context.num_solved++;
+}
+
+// Solver thread: one solver instance reused for every puzzle it pops. With a
+// node, the thread runs on that node's CPUs (its heuristic reads the node's
+// PDB replica).
+template <typename Variant, typename Heuristic>
+void SolveFromQueue(int core_num, const Heuristic& heuristic, const Numa::Node* node, SolverContext& context,
+                    InstanceQueue& queue, WorkerCounters& counters) {
+    if (node && !Numa::BindThread(*node)) {
+        std::cerr << "Worker " << core_num << ": binding to NUMA node " << node->id << " failed\n";
+    }
+    IDAstar<Variant, Heuristic> solver(heuristic, context.move_pruning, context.transposition_table, &counters);
+    std::unique_ptr<Astar<Variant, Heuristic>> astar;
+    if (context.astar) astar.reset(new Astar<Variant, Heuristic>(heuristic, context.astar_memory_mb, &counters));
+    // Counters belong to the thread that opens them
+    std::unique_ptr<PerfCounters> perf;
+    if (context.perf) perf.reset(new PerfCounters());
+    Instance instance;
+    while (queue.Pop(instance)) {
+        if (cancel_token.IsCancelled()) {
+            queue.Close(); // Unblocks the reader, which then stops reading
+            continue;
+        }
+        SolvePuzzleAndWrite(solver, astar.get(), instance, core_num, context, counters, perf.get());
+    }
+}
+
+// heuristics holds one heuristic, or one per entry of nodes (replicated
+// PDBs); worker i then runs on nodes[i % nodes.size()] with that node's copy
+template <typename Variant, typename Heuristic>
+void SolveAll(const std::vector<Heuristic>& heuristics, const std::vector<Numa::Node>& nodes, SolverContext& context,
+              const Options& options) {
+    // One counter slot per solver thread; a reporter thread samples them and
+    // writes per-worker rows to the telemetry CSV
+    Telemetry telemetry(options.num_threads);
+    std::ofstream telemetry_csv;
+    if (options.report_interval > 0) {
+        telemetry_csv.open(options.output_dir + "/telemetry_" + context.solver_name + ".csv");
+        telemetry.Start(options.report_interval, std::cout, telemetry_csv.is_open() ? &telemetry_csv : nullptr);
+    }
+
+    // Workers start on the first parsed line; the reader blocks while the
+    // queue is full, so the input is never held in memory
+    InstanceQueue queue(4 * options.num_threads);
+    std::vector<std::thread> workers;
+    const bool bind = heuristics.size() > 1;
+    for (int i = 0; i < options.num_threads; ++i) {
+        size_t replica = bind ? i % heuristics.size() : 0;
+        workers.emplace_back(SolveFromQueue<Variant, Heuristic>, i, std::cref(heuristics[replica]),
+                             bind ? &nodes[replica] : nullptr, std::ref(context), std::ref(queue),
+                             std::ref(telemetry.Worker(i)));
+    }
+
+    int next_id = 1;
+    long long num_read = 0;
+    for (const auto& input : options.inputs) {
+        if (input == "-") {
+            num_read += ReadInstances(std::cin, "stdin", next_id, queue);
+            continue;
+        }
+        std::ifstream infile(input);
+        if (!infile) {
+            std::cerr << "Failed to open instance file: " << input << "\n";
+            continue;
+        }
+        num_read += ReadInstances(infile, input, next_id, queue);
+    }
+    queue.Close();
+    std::cout << "Read " << num_read << " puzzles\n";
+
+    // Wait for all threads to finish
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    telemetry.Stop();
+}
+
+// NUMA placement of the loaded PDBs. replicate: one copy per node, made by a
+// thread bound to that node (so first touch allocates locally) and then bound
+// there; falls back to interleave when a node has no room for a copy.
+// Returns one database set per node, or the original set alone.
+std::vector<std::vector<PatternDatabase>> PlaceDatabases(std::vector<PatternDatabase> databases, Numa::Policy policy,
+                                                         const std::vector<Numa::Node>& nodes) {
+    std::vector<std::vector<PatternDatabase>> replicas;
+    uint64_t bytes = 0;
+    for (const auto& database : databases) bytes += database.table.size();
+
+    if (policy == Numa::Policy::Replicate && nodes.size() > 1) {
+        // Free memory now that the loaded copy is resident; the last replica
+        // takes over the loaded copy's pages, every other one is a new copy
+        bool fits = true;
+        for (const auto& node : Numa::Nodes()) fits = fits && node.free_bytes > bytes + bytes / 8;
+        if (fits) {
+            replicas.resize(nodes.size());
+            for (size_t n = 0; n < nodes.size(); ++n) {
+                std::thread([&, n] {
+                    Numa::BindThread(nodes[n]);
+                    replicas[n] = (n + 1 < nodes.size()) ? databases : std::move(databases);
+                    for (auto& database : replicas[n]) {
+                        Numa::BindMemory(database.table.data(), database.table.size(), nodes[n].id);
+                    }
+                }).join();
+            }
+            std::cout << "PDBs replicated on " << nodes.size() << " NUMA nodes (" << (bytes >> 20) << " MB each)\n";
+            return replicas;
+        }
+        std::cout << "PDB replicas (" << (bytes >> 20) << " MB each) do not fit on every NUMA node, interleaving\n";
+        policy = Numa::Policy::Interleave;
+    }
+    if (policy == Numa::Policy::Interleave && nodes.size() > 1) {
+        bool ok = true;
+        for (auto& database : databases) {
+            ok = Numa::InterleaveMemory(database.table.data(), database.table.size(), nodes) && ok;
+        }
+        std::cout << (ok ? "PDBs interleaved over " : "Interleaving failed over ") << nodes.size() << " NUMA nodes\n";
+    } else if (policy != Numa::Policy::Off) {
+        std::cout << "Single NUMA node, PDB placement unchanged\n";
+    }
+    replicas.push_back(std::move(databases));
+    return replicas;
+}
+
+// Builds the heuristic chosen on the command line and runs the batch with the
+// matching specialization
+template <typename Variant>
+int Run(const Options& options, SolverContext& context) {
+    const std::vector<Numa::Node> nodes = Numa::Nodes();
+    if (options.heuristic == "md") {
+        SolveAll<Variant>(std::vector<ManhattanHeuristic<Variant>>(1), nodes, context, options);
+    } else if (options.heuristic == "wd") {
+        WalkingDistance walking_distance;
+        walking_distance.LoadOrBuild(options.wd_file);
+        std::vector<WalkingDistanceHeuristic<Variant>> heuristics{WalkingDistanceHeuristic<Variant>(&walking_distance)};
+        SolveAll<Variant>(heuristics, nodes, context, options);
+    } else {
+        if (options.pdb_files.size() > static_cast<size_t>(PDBHeuristic<Variant>::kMaxDatabases)) {
+            std::cerr << "At most " << PDBHeuristic<Variant>::kMaxDatabases << " pattern databases are supported\n";
+            return 1;
+        }
+        std::vector<PatternDatabase> databases(options.pdb_files.size());
+        for (size_t d = 0; d < databases.size(); ++d) {
+            if (!databases[d].Load(options.pdb_files[d], options.patterns[d], Variant::kNumber)) return 1;
+            if (Variant::kNumber != 1 && databases[d].VariantOneOnly()) {
+                std::cerr << options.pdb_files[d] << ": " << PDBFormat::ToString(databases[d].encoding)
+                          << " pattern databases are variant 1 only\n";
+                return 1;
+            }
+            if (context.astar && databases[d].Mod()) {
+                std::cerr << options.pdb_files[d] << ": A* cannot use mod pattern databases\n";
+                return 1;
+            }
+        }
+        std::cout << "PDBs have been read into memory." << std::endl;
+        const auto replicas = PlaceDatabases(std::move(databases), options.numa, nodes);
+        std::vector<PDBHeuristic<Variant>> heuristics;
+        for (const auto& replica : replicas) heuristics.emplace_back(&replica);
+        SolveAll<Variant>(heuristics, nodes, context, options);
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    try {
+        ParseOptions(argc, argv, options);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    // The move pruning FSM and the transposition table assume unit move
+    // costs, which hold for both variants
+    MovePruningFSM move_pruning;
+    if (options.fsm_file != "none") {
+        move_pruning.LoadOrBuild(options.fsm_file, options.variant, MovePruningFSM::DefaultDepth(options.variant));
+    }
+    std::unique_ptr<TranspositionTable> transposition_table;
+    if (options.tt_size_mb > 0) {
+        transposition_table.reset(new TranspositionTable(options.tt_size_mb));
+    }
+
+    std::string solver_name = "v" + std::to_string(options.variant) + "_" + options.heuristic;
+    StatsSink stats_sink(options.stats_file.empty() ? options.output_dir + "/iteration_stats_" + solver_name + ".csv"
+                                                    : options.stats_file);
+
+    SolverContext context;
+    context.solver_name = solver_name;
+    context.variant = options.variant;
+    context.output_dir = options.output_dir;
+    context.write_results = options.write_results;
+    context.move_pruning = (options.fsm_file != "none") ? &move_pruning : nullptr;
+    context.transposition_table = transposition_table.get();
+    context.stats_sink = &stats_sink;
+    context.summary.open(options.output_dir + "/summary_" + solver_name + ".csv");
+    if (!context.summary) {
+        std::cerr << "Failed to open summary file in " << options.output_dir << "\n";
+        return 1;
+    }
+    context.summary << "puzzle,status,solution_length,lower_bound,nodes_expanded,nodes_generated,time_s\n";
+    context.limits.max_nodes = options.max_nodes;
+    context.limits.max_seconds = options.max_time;
+    context.limits.cancel = &cancel_token;
+    context.checkpoint_dir = options.checkpoint_dir;
+    context.checkpoint_solver = solver_name + (context.move_pruning ? "+fsm" : "");
+    context.perf = options.perf;
+    context.astar = (options.engine == "astar");
+    context.astar_memory_mb = options.astar_memory_mb;
+    if (context.perf) {
+        PerfCounters probe;
+        if (!probe.Available()) {
+            std::cerr << "Hardware counters unavailable, --perf ignored: " << probe.Error() << "\n";
+            context.perf = false;
+        } else {
+            context.perf_csv.open(options.output_dir + "/perf_" + solver_name + ".csv");
+            context.perf_csv << "puzzle,status,nodes_expanded," << PerfSample::CsvHeader() << "\n";
+        }
+    }
+    std::signal(SIGINT, HandleStopSignal);
+    std::signal(SIGTERM, HandleStopSignal);
+
+    int status = (options.variant == 1) ? Run<Variant1>(options, context)
+                                        : Run<Variant2>(options, context);
+    if (status != 0) return status;
+
+    std::cout << "All puzzles processed (" << context.num_solved << " solved, " << context.num_stopped
+              << " stopped by a limit" << (cancel_token.IsCancelled() ? ", run cancelled" : "") << ").\n";
+    if (context.perf) {
+        std::cout << "Hardware counters over " << context.perf_nodes << " expanded nodes: ";
+        context.perf_total.Print(std::cout, context.perf_nodes);
+    }
+    return 0;
+}
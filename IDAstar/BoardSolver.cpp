@@ -0,0 +1,144 @@
+#include "IDAstar.h"
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Solves sliding-tile instances on any supported board (8-, 15- and
+// 24-puzzle) with Manhattan distance or additive PDBs built by
+// ParallelPDBGenerator --board. One instance per line, rows x cols numbers
+// row by row (0 is the blank); lines starting with # are skipped.
+//
+//   BoardSolver --board 3x3 --variant 1 instances.txt
+//   BoardSolver --board 5x5 --variant 1 --pdb p1.bin 1,2,3,4,5,6 --pdb p2.bin 7,8,9 ... instances.txt
+//
+// Move pruning automata, the transposition table and walking distance are
+// 15-puzzle features; BatchSolver remains the driver for those.
+
+struct Options {
+    std::string board = "4x4";
+    int variant = 1;
+    std::vector<std::string> pdb_files;
+    std::vector<std::vector<int>> patterns; // Blank excluded
+    std::string instance_file;
+    double max_time = 0.0;                  // Seconds per instance, 0: unlimited
+};
+
+std::vector<int> ParsePattern(const std::string& list) {
+    std::vector<int> pattern;
+    std::istringstream iss(list);
+    std::string tile;
+    while (std::getline(iss, tile, ',')) {
+        if (!tile.empty()) pattern.push_back(std::stoi(tile));
+    }
+    return pattern;
+}
+
+template <typename Variant, typename Heuristic>
+int SolveAll(const Heuristic& heuristic, const Options& options) {
+    using Puzzle = typename Variant::Puzzle;
+
+    std::ifstream file(options.instance_file);
+    if (!file) {
+        std::cerr << "Failed to open " << options.instance_file << "\n";
+        return 1;
+    }
+
+    IDAstar<Variant, Heuristic> solver(heuristic);
+    SearchLimits limits;
+    limits.max_seconds = options.max_time;
+    std::ofstream no_output;
+    long long total_nodes = 0;
+    double total_time = 0.0;
+    int line_num = 0;
+    int solved = 0;
+    std::string line;
+    while (std::getline(file, line)) {
+        ++line_num;
+        if (line.empty() || line[0] == '#') continue;
+        std::istringstream iss(line);
+        typename Puzzle::Tiles tiles;
+        bool complete = true;
+        for (int& tile : tiles) complete = complete && static_cast<bool>(iss >> tile);
+        if (!complete || !Puzzle::IsSolvable(tiles)) {
+            std::cerr << "Line " << line_num << ": not a solvable " << options.board << " instance\n";
+            continue;
+        }
+
+        Puzzle puzzle(tiles, Variant::kNumber);
+        auto result = solver.Solve(puzzle, [](int, const IterationStats&, std::ofstream&) {}, 0, no_output, limits);
+        total_nodes += std::get<3>(result);
+        total_time += std::get<2>(result);
+        std::cout << "Line " << line_num << ": ";
+        if (solver.Status() == SolveStatus::Solved) {
+            ++solved;
+            std::cout << "length " << std::get<1>(result);
+        } else {
+            std::cout << ToString(solver.Status()) << " (lower bound " << solver.LowerBound() << ")";
+        }
+        std::cout << ", nodes " << std::get<3>(result) << ", " << std::fixed << std::setprecision(3)
+                  << std::get<2>(result) << " s\n";
+        std::cout.unsetf(std::ios::floatfield);
+    }
+    std::cout << "Solved " << solved << " instances, " << total_nodes << " nodes in " << std::fixed
+              << std::setprecision(3) << total_time << " s\n";
+    return 0;
+}
+
+template <typename Variant>
+int SolveWith(const Options& options) {
+    if (options.pdb_files.empty()) return SolveAll<Variant>(ManhattanHeuristic<Variant>(), options);
+
+    std::vector<PatternDatabase> databases(options.pdb_files.size());
+    for (size_t d = 0; d < databases.size(); ++d) {
+        if (!databases[d].Load(options.pdb_files[d], options.patterns[d], Variant::kNumber, Variant::kRows, Variant::kCols)) return 1;
+        if (Variant::kNumber != 1 && databases[d].VariantOneOnly()) {
+            std::cerr << options.pdb_files[d] << ": " << PDBFormat::ToString(databases[d].encoding)
+                      << " pattern databases are variant 1 only\n";
+            return 1;
+        }
+    }
+    return SolveAll<Variant>(PDBHeuristic<Variant>(&databases), options);
+}
+
+template <int kRows, int kCols>
+int SolveOnBoard(const Options& options) {
+    return (options.variant == 1) ? SolveWith<Variant<1, kRows, kCols>>(options)
+                                  : SolveWith<Variant<2, kRows, kCols>>(options);
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--board") == 0 && i + 1 < argc) {
+            options.board = argv[++i];
+        } else if (std::strcmp(argv[i], "--variant") == 0 && i + 1 < argc) {
+            options.variant = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--pdb") == 0 && i + 2 < argc) {
+            options.pdb_files.push_back(argv[++i]);
+            options.patterns.push_back(ParsePattern(argv[++i]));
+        } else if (std::strcmp(argv[i], "--max-time") == 0 && i + 1 < argc) {
+            options.max_time = std::atof(argv[++i]);
+        } else if (argv[i][0] != '-' && options.instance_file.empty()) {
+            options.instance_file = argv[i];
+        } else {
+            options.instance_file.clear();
+            break;
+        }
+    }
+    if (options.instance_file.empty() || (options.variant != 1 && options.variant != 2) ||
+        options.pdb_files.size() > PDBHeuristic<Variant1>::kMaxDatabases) {
+        std::cerr << "Usage: " << argv[0] << " [--board 3x3|4x4|5x5] [--variant 1|2] [--pdb file tiles,..]..."
+                  << " [--max-time s] instances.txt\n";
+        return 1;
+    }
+
+    if (options.board == "3x3") return SolveOnBoard<3, 3>(options);
+    if (options.board == "4x4") return SolveOnBoard<4, 4>(options);
+    if (options.board == "5x5") return SolveOnBoard<5, 5>(options);
+    std::cerr << "Unsupported board " << options.board << " (3x3, 4x4 or 5x5)\n";
+    return 1;
+}
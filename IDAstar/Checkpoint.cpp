@@ -0,0 +1,87 @@
+#include "Checkpoint.h"
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace {
+    const char kDirections[] = {'L', 'R', 'U', 'D'}; // Indexed by Direction
+}
+
+bool Checkpoint::Save(const std::string& filepath) const {
+    const std::string temp_path = filepath + ".tmp";
+    {
+        std::ofstream out(temp_path);
+        if (!out) return false;
+        out << "puzzle " << puzzle_num << "\n";
+        out << "tiles";
+        for (int tile : tiles) out << " " << tile;
+        out << "\n";
+        out << "solver " << solver << "\n";
+        out << "solved " << (solved ? 1 : 0) << "\n";
+        out << "bound " << bound << "\n";
+        out << "frontier_min " << (frontier_min == kNoFrontier ? -1 : frontier_min) << "\n";
+        out << "iterations " << iterations << "\n";
+        out << "nodes " << nodes_expanded << " " << nodes_generated << "\n";
+        out << "elapsed " << std::setprecision(9) << elapsed << "\n";
+        out << "path";
+        for (const auto& action : path) out << " " << kDirections[action.dir] << action.steps;
+        out << "\n";
+        if (!out.flush()) return false;
+    }
+    return std::rename(temp_path.c_str(), filepath.c_str()) == 0;
+}
+
+bool Checkpoint::Load(const std::string& filepath) {
+    std::ifstream in(filepath);
+    if (!in) return false;
+
+    Checkpoint loaded;
+    int fields = 0;
+    std::string line;
+    while (std::getline(in, line)) {
+        std::istringstream iss(line);
+        std::string key;
+        if (!(iss >> key)) continue;
+        if (key == "puzzle") {
+            iss >> loaded.puzzle_num;
+        } else if (key == "tiles") {
+            int tile;
+            while (iss >> tile) loaded.tiles.push_back(tile);
+            if (loaded.tiles.empty()) return false;
+            iss.clear();
+        } else if (key == "solver") {
+            iss >> loaded.solver;
+        } else if (key == "solved") {
+            int value = 0;
+            iss >> value;
+            loaded.solved = (value != 0);
+        } else if (key == "bound") {
+            iss >> loaded.bound;
+        } else if (key == "frontier_min") {
+            iss >> loaded.frontier_min;
+            if (loaded.frontier_min < 0) loaded.frontier_min = kNoFrontier;
+        } else if (key == "iterations") {
+            iss >> loaded.iterations;
+        } else if (key == "nodes") {
+            iss >> loaded.nodes_expanded >> loaded.nodes_generated;
+        } else if (key == "elapsed") {
+            iss >> loaded.elapsed;
+        } else if (key == "path") {
+            std::string move;
+            while (iss >> move) {
+                int dir = 0;
+                while (dir < 4 && kDirections[dir] != move[0]) ++dir;
+                if (dir == 4 || move.size() < 2) return false;
+                loaded.path.push_back({static_cast<Direction>(dir), std::stoi(move.substr(1))});
+            }
+        } else {
+            continue;
+        }
+        if (key != "path" && iss.fail()) return false;
+        ++fields;
+    }
+    if (fields < 10) return false;
+    *this = loaded;
+    return true;
+}
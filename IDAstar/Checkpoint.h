@@ -0,0 +1,41 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include "../Puzzle/Puzzle.h"
+#include <array>
+#include <limits>
+#include <string>
+#include <vector>
+
+// Progress of one solve, saved so that a restarted process can continue where
+// the previous one stopped instead of repeating finished iterations.
+//
+// After every finished iteration the solver reports the next bound; when a
+// limit or cancellation stops it mid-iteration it also reports its DFS
+// position (the moves from the root to the node it was about to expand) and
+// the smallest f beyond the bound seen so far. Resuming replays that path and
+// skips every subtree ordered before it.
+struct Checkpoint {
+    static const int kNoFrontier = std::numeric_limits<int>::max();
+
+    int puzzle_num = 0;
+    std::vector<int> tiles;            // Initial state, row by row
+    std::string solver;                // Configuration that produced `path`, e.g. v1_pdb+fsm
+    bool solved = false;
+    int bound = 0;                     // Next bound to search, or the solution length once solved
+    int frontier_min = kNoFrontier;    // Smallest f > bound in the finished part of the iteration
+    std::vector<Action> path;          // DFS position inside the iteration; empty: start at the root
+    int iterations = 0;                // Finished iterations
+    long long nodes_expanded = 0;
+    long long nodes_generated = 0;
+    double elapsed = 0.0;              // Seconds over all runs
+
+    bool HasPosition() const { return !path.empty() || frontier_min != kNoFrontier; }
+
+    // Text format, one "key values" line per field. Save() writes a temporary
+    // file and renames it, so a crash never leaves a truncated checkpoint.
+    bool Save(const std::string& filepath) const;
+    bool Load(const std::string& filepath);
+};
+
+#endif // CHECKPOINT_H
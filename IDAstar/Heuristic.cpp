@@ -0,0 +1,158 @@
+#include "Heuristic.h"
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+void PatternDatabase::SetPattern(const std::vector<int>& pattern, int rows, int num_cols) {
+    cells = rows * num_cols;
+    cols = num_cols;
+    tiles = pattern;
+    std::sort(tiles.begin(), tiles.end());
+
+    // multipliers[i] = (cells - 1 - i)! / (cells - k)!, the number of
+    // placements of the remaining pattern tiles
+    int k = tiles.size();
+    multipliers.assign(k, 1);
+    for (int i = 0; i < k; ++i) {
+        for (int j = 0; j < k - i - 1; ++j) {
+            multipliers[i] *= (cells - i - 1 - j);
+        }
+    }
+
+    manhattan.assign(k * cells, 0);
+    for (int i = 0; i < k; ++i) {
+        for (int cell = 0; cell < cells; ++cell) {
+            manhattan[i * cells + cell] = static_cast<uint8_t>(std::abs(tiles[i] / cols - cell / cols) +
+                                                               std::abs(tiles[i] % cols - cell % cols));
+        }
+    }
+}
+
+bool PatternDatabase::Load(const std::string& filepath, const std::vector<int>& pattern, int variant, int rows,
+                           int num_cols) {
+    SetPattern(pattern, rows, num_cols);
+
+    std::ifstream file(filepath, std::ios::binary);
+    if (!file) {
+        std::cerr << "Failed to open PDB file: " << filepath << "\n";
+        return false;
+    }
+    PDBFormat::Header header;
+    const PDBFormat::HeaderStatus header_status = PDBFormat::ReadHeader(file, header);
+    if (header_status == PDBFormat::HeaderStatus::OtherVersion) {
+        std::cerr << "PDB file " << filepath << " has header version "
+                  << static_cast<int>(header.magic[PDBFormat::kVersionByte]) << ", expected "
+                  << static_cast<int>(PDBFormat::kMagic[PDBFormat::kVersionByte]) << "; regenerate it\n";
+        return false;
+    }
+    if (header_status == PDBFormat::HeaderStatus::None) {
+        std::cerr << "PDB file " << filepath << " has no header, so its variant is unknown; regenerate it\n";
+        return false;
+    }
+    encoding = static_cast<PDBFormat::Encoding>(header.encoding);
+    if (encoding != PDBFormat::Encoding::Raw && encoding != PDBFormat::Encoding::Mod &&
+        encoding != PDBFormat::Encoding::Min && encoding != PDBFormat::Encoding::Delta) {
+        std::cerr << "PDB file " << filepath << " has unknown encoding " << header.encoding << "\n";
+        return false;
+    }
+    if (variant != 0 && header.variant != static_cast<uint32_t>(variant)) {
+        std::cerr << "PDB file " << filepath << " is for variant " << header.variant << ", the solver runs variant "
+                  << variant << "\n";
+        return false;
+    }
+    uint64_t num_states = NumStates();
+    if (header.num_states != num_states) {
+        std::cerr << "PDB file " << filepath << " has " << header.num_states << " entries, pattern needs "
+                  << num_states << "\n";
+        return false;
+    }
+    group_size = (encoding == PDBFormat::Encoding::Min || Delta()) ? header.group_size : 1;
+    if (group_size < 1) {
+        std::cerr << "PDB file " << filepath << " has group size 0\n";
+        return false;
+    }
+    if (Delta()) std::copy(header.symbols, header.symbols + PDBFormat::kDeltaSymbols, symbols.begin());
+
+    modulus = Mod() ? header.modulus : 0;
+    code_bits = Mod() ? PDBFormat::ModBits(modulus) : 0;
+    if (Mod() && (modulus < 3 || modulus % 2 == 0 || code_bits > PDBFormat::kMaxModBits)) {
+        std::cerr << "PDB file " << filepath << " has modulus " << modulus << ", expected 2D + 1 for a small D\n";
+        return false;
+    }
+    for (uint64_t value = 0; Mod() && value < residues.size(); ++value) residues[value] = value % modulus;
+    for (uint64_t i = 0; Mod() && i < 2 * modulus; ++i) {
+        const int difference = static_cast<int>(i % modulus);
+        steps[i] = static_cast<int8_t>(difference > static_cast<int>(modulus / 2) ? difference - modulus : difference);
+    }
+
+    // One allocation of the table size, read in place
+    const std::streampos start = file.tellg();
+    file.seekg(0, std::ios::end);
+    table.resize(static_cast<size_t>(file.tellg() - start));
+    backing = HugePages::LastBacking();
+    file.seekg(start);
+    file.read(reinterpret_cast<char*>(table.data()), table.size());
+    if (!file) {
+        std::cerr << "Failed to read PDB file: " << filepath << "\n";
+        return false;
+    }
+    std::cout << "PDB " << filepath << ": " << table.size() / (1 << 20) << " MB " << PDBFormat::ToString(encoding);
+    if (group_size > 1) std::cout << " (" << group_size << " ranks per " << (Delta() ? "block)" : "entry)");
+    std::cout << " on " << HugePages::ToString(backing) << "\n";
+
+    uint64_t table_bytes = Mod() ? PDBFormat::ModBytes(num_states, code_bits) : PDBFormat::MinBytes(num_states, group_size);
+    if (Delta()) table_bytes *= PDBFormat::kDeltaBlockBytes;
+    if (table.size() < table_bytes) {
+        std::cerr << "PDB file " << filepath << " has " << table.size() << " bytes, pattern needs "
+                  << table_bytes << "\n";
+        return false;
+    }
+    return true;
+}
+
+// Every state but the goal has a neighbour below it (the first pattern tile
+// move of its optimal abstract path leads to one), and the codes of two
+// neighbours give their exact difference. Stepping to the lowest neighbour
+// until none is lower ends at the goal, and the steps add up to h.
+uint8_t PatternDatabase::DescendToGoal(std::vector<int> pattern_positions) const {
+    auto rank = [&](const std::vector<int>& positions) {
+        std::array<uint8_t, 64> by_tile{};
+        for (size_t i = 0; i < tiles.size(); ++i) by_tile[tiles[i]] = static_cast<uint8_t>(positions[i]);
+        return Rank(by_tile);
+    };
+    const int steps_to[4] = {-1, 1, -cols, cols};
+    const uint8_t unreachable = PDBFormat::ModUnreachable(code_bits);
+
+    int h = 0;
+    while (true) {
+        const int code = PDBFormat::ModCode(table.data(), rank(pattern_positions), code_bits);
+        uint64_t occupied = 0;
+        for (int pos : pattern_positions) occupied |= 1ULL << pos;
+        int lowest = 0;
+        size_t lowest_tile = 0;
+        int lowest_to = -1;
+        for (size_t i = 0; i < tiles.size(); ++i) {
+            const int from = pattern_positions[i];
+            for (int step : steps_to) {
+                const int to = from + step;
+                if (to < 0 || to >= cells || (occupied & (1ULL << to))) continue;
+                if ((step == -1 || step == 1) && to / cols != from / cols) continue;
+                pattern_positions[i] = to;
+                const int neighbour = PDBFormat::ModCode(table.data(), rank(pattern_positions), code_bits);
+                pattern_positions[i] = from;
+                if (neighbour == unreachable) continue;
+                const int difference = steps[neighbour + modulus - code];
+                if (difference < lowest) {
+                    lowest = difference;
+                    lowest_tile = i;
+                    lowest_to = to;
+                }
+            }
+        }
+        if (lowest_to < 0) return static_cast<uint8_t>(h);
+        pattern_positions[lowest_tile] = lowest_to;
+        h -= lowest;
+    }
+}
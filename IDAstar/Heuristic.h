@@ -0,0 +1,417 @@
+#ifndef HEURISTIC_H
+#define HEURISTIC_H
+
+#include "Variant.h"
+#include "../Heuristics/WalkingDistance.h"
+#include "../Search/HugePages.h"
+#include "../Search/PDBFormat.h"
+#include "../Search/Ranking.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Heuristics of the unified solver. Each one keeps a small per-node State that
+// the search copies down the path and updates incrementally per move:
+//   State Root(const Board&)                      from-scratch evaluation
+//   State Child(parent, board, move)              board is the parent's board
+//   void PrepareChildren(parent, board,           Child for each of count moves, but
+//                        moves, count, children)  table reads may be left pending
+//   void FinishChild(State&)                      (prefetched) until FinishChild, so
+//                                                 the children are ranked together
+//                                                 and their misses overlap
+//   int Value(const State&)                       h in moves
+//   static const bool kConsistent                 false enables BPMX/pathmax
+//   static const bool kMoveBound                  true if the search may call
+//   int MoveBound(parent, board, move, child)     a lower bound on the child's h
+//                                                 from the move alone, cheaper
+//                                                 than evaluating the child; it
+//                                                 fills the part of child it used
+//   void PrepareBounded(parent, board,            PrepareChildren for children
+//                       moves, count, children)   MoveBound started: completes them
+
+// Manhattan distance. Variant 2 moves up to kMaxSlide tiles (3 on the
+// 15-puzzle) one column per slide, so its horizontal part is the sum of
+// horizontal distances divided by kMaxSlide (rounded up); the per-tile
+// rounding used by the old STP2 solver overestimated tiles 2 columns away.
+template <typename Variant>
+class ManhattanHeuristic {
+public:
+    static const bool kConsistent = true;
+    static const bool kMoveBound = true;
+    using Board = typename Variant::Board;
+
+    struct State {
+        int vertical;
+        int horizontal;
+    };
+
+    State Root(const Board& board) const {
+        State state{0, 0};
+        for (int p = 0; p < Variant::kCells; ++p) {
+            int tile = board.tiles[p];
+            if (tile == 0) continue;
+            state.vertical += RowDistance(tile, p);
+            state.horizontal += ColDistance(tile, p);
+        }
+        return state;
+    }
+
+    State Child(const State& parent, const Board& board, const Move& move) const {
+        State child = parent;
+        if (move.step == Variant::kCols || move.step == -Variant::kCols) {
+            int tile = board.tiles[move.target];
+            child.vertical += RowDistance(tile, move.from) - RowDistance(tile, move.target);
+        } else if (Variant::kMaxSlide == 1) {
+            int tile = board.tiles[move.target];
+            child.horizontal += ColDistance(tile, move.from) - ColDistance(tile, move.target);
+        } else {
+            // Every tile between the blank and its target shifts one column
+            for (int p = move.from + move.step; ; p += move.step) {
+                int tile = board.tiles[p];
+                child.horizontal += ColDistance(tile, p - move.step) - ColDistance(tile, p);
+                if (p == move.target) break;
+            }
+        }
+        return child;
+    }
+
+    void PrepareChildren(const State& parent, const Board& board, const Move* const* moves, int count,
+                         State* children) const {
+        for (int c = 0; c < count; ++c) children[c] = Child(parent, board, *moves[c]);
+    }
+    void FinishChild(State&) const {}
+
+    // Exact: the child's Manhattan distance, and child is complete
+    int MoveBound(const State& parent, const Board& board, const Move& move, State& child) const {
+        child = Child(parent, board, move);
+        return Value(child);
+    }
+    void PrepareBounded(const State&, const Board&, const Move* const*, int, State*) const {}
+
+    int Value(const State& state) const {
+        return state.vertical + (state.horizontal + Variant::kMaxSlide - 1) / Variant::kMaxSlide;
+    }
+
+private:
+    static int RowDistance(int tile, int pos) { return std::abs(tile / Variant::kCols - pos / Variant::kCols); }
+    static int ColDistance(int tile, int pos) { return std::abs(tile % Variant::kCols - pos % Variant::kCols); }
+};
+
+// max(Manhattan distance, walking distance). The WD table is shared read-only
+// by all solver threads; its variant-2 column table is slide-aware. The
+// tables are built for the 15-puzzle.
+template <typename Variant>
+class WalkingDistanceHeuristic {
+    static_assert(Variant::kRows == 4 && Variant::kCols == 4, "Walking distance tables are 4x4");
+
+public:
+    static const bool kConsistent = true;
+    static const bool kMoveBound = true;
+    using Board = typename Variant::Board;
+
+    struct State {
+        typename ManhattanHeuristic<Variant>::State md;
+        WalkingDistance::State wd;
+    };
+
+    explicit WalkingDistanceHeuristic(const WalkingDistance* walking_distance) : walking_distance(walking_distance) {}
+
+    State Root(const Board& board) const {
+        return State{manhattan.Root(board), walking_distance->GetState(board.tiles)};
+    }
+
+    State Child(const State& parent, const Board& board, const Move& move) const {
+        return State{manhattan.Child(parent.md, board, move),
+                     walking_distance->ApplyAction(parent.wd, board.tiles, board.blank / 4, board.blank % 4, move.action)};
+    }
+
+    // The WD tables are small enough to stay cached
+    void PrepareChildren(const State& parent, const Board& board, const Move* const* moves, int count,
+                         State* children) const {
+        for (int c = 0; c < count; ++c) children[c] = Child(parent, board, *moves[c]);
+    }
+    void FinishChild(State&) const {}
+
+    // The child's Manhattan distance, without the WD transition, which
+    // PrepareBounded adds
+    int MoveBound(const State& parent, const Board& board, const Move& move, State& child) const {
+        return manhattan.MoveBound(parent.md, board, move, child.md);
+    }
+    void PrepareBounded(const State& parent, const Board& board, const Move* const* moves, int count,
+                        State* children) const {
+        for (int c = 0; c < count; ++c) {
+            children[c].wd = walking_distance->ApplyAction(parent.wd, board.tiles, board.blank / 4, board.blank % 4,
+                                                           moves[c]->action);
+        }
+    }
+
+    int Value(const State& state) const {
+        return std::max(manhattan.Value(state.md), walking_distance->HeuristicsCost(state.wd, Variant::kNumber));
+    }
+
+private:
+    ManhattanHeuristic<Variant> manhattan;
+    const WalkingDistance* walking_distance;
+};
+
+// One pattern database as written by GeneratePDB: the pattern's tiles (blank
+// excluded) ranked by their positions in ascending tile order, over the
+// board's `cells` positions. The table is allocated under the HugePages
+// policy; backing records what it got.
+//
+// A mod table (PDBFormat::Encoding::Mod, variant 1) stores the exact h mod
+// 2D + 1, D the largest difference between entries one pattern-tile step
+// apart, which pins down a child's h given its parent's. The search carries
+// every database's exact value down the path; only the root's is found by
+// descending through the table to the goal.
+//
+// A min-compressed table (PDBFormat::Encoding::Min, from CompressPDB) holds
+// one entry per group_size adjacent ranks, the group's minimum.
+//
+// A delta table (PDBFormat::Encoding::Delta, variant 1) holds the entry's
+// excess over the pattern tiles' Manhattan distance, coded in 64-byte blocks
+// of group_size ranks. An entry is the distance, summed from a per-tile
+// table, plus twice the symbol decoded from its block.
+struct PatternDatabase {
+    HugePageVector<uint8_t> table;     // One byte per rank (group of ranks for min), packed codes (mod) or 64-byte blocks (delta)
+    HugePages::Backing backing = HugePages::Backing::Heap;
+    PDBFormat::Encoding encoding = PDBFormat::Encoding::Raw;
+    uint64_t modulus = 0;              // Mod: 2D + 1
+    int code_bits = 0;                 // Mod: bits per rank
+    std::array<uint8_t, 256> residues{}; // Mod: value mod modulus
+    std::array<int8_t, 512> steps{};   // Mod: [code + modulus - residue] -> difference to the parent's value
+    uint64_t group_size = 1;           // Ranks per entry (min) or per block (delta)
+    std::array<uint8_t, PDBFormat::kDeltaSymbols> symbols{}; // Delta: excess / 2 of each code
+    std::vector<uint8_t> manhattan;    // [pattern tile index * cells + cell]: the tile's distance home
+    std::vector<int> tiles;            // Pattern tiles, ascending
+    std::vector<uint64_t> multipliers; // Ranking weights per pattern tile
+    int cells = 16;                    // Board positions
+    int cols = 4;
+
+    // Files with a header must be written for variant (variant-2 entries are
+    // sixths); 0 accepts either, for benchmarks that only time the lookups
+    bool Load(const std::string& filepath, const std::vector<int>& pattern, int variant, int rows = 4, int cols = 4);
+    void SetPattern(const std::vector<int>& pattern, int rows = 4, int cols = 4); // Tiles and multipliers only
+    uint64_t NumStates() const { return tiles.empty() ? 1 : multipliers[0] * cells; }
+    bool Mod() const { return encoding == PDBFormat::Encoding::Mod; }
+    bool Delta() const { return encoding == PDBFormat::Encoding::Delta; }
+    bool VariantOneOnly() const { return Mod() || Delta(); }
+
+    // Byte entry of a rank in a raw or min table, block of a delta table
+    uint64_t Index(uint64_t rank) const { return group_size == 1 ? rank : rank / group_size; }
+
+    // Cache line of a rank's entry, for prefetching
+    const uint8_t* EntryAddress(uint64_t rank) const {
+        if (Mod()) return &table[(rank * code_bits) >> 3];
+        return Delta() ? &table[Index(rank) * PDBFormat::kDeltaBlockBytes] : &table[Index(rank)];
+    }
+
+    // Exact entry of a child state whose parent's entry was parent_value;
+    // positions[tile] is the child's cell of each tile
+    template <size_t kCells>
+    uint8_t ChildValue(uint8_t parent_value, uint64_t rank, const std::array<uint8_t, kCells>& positions) const {
+        if (Delta()) return DeltaValue(rank, positions);
+        if (!Mod()) return table[Index(rank)];
+        // The child's h is within D of parent_value: the one with its code
+        const int code = PDBFormat::ModCode(table.data(), rank, code_bits);
+        return static_cast<uint8_t>(parent_value + steps[code + modulus - residues[parent_value]]);
+    }
+
+    // Exact entry from scratch; positions[tile] is the tile's cell
+    template <size_t kCells>
+    uint8_t RootValue(const std::array<uint8_t, kCells>& positions) const {
+        if (Delta()) return DeltaValue(Rank(positions), positions);
+        if (!Mod()) return table[Index(Rank(positions))];
+        std::vector<int> pattern_positions;
+        for (int tile : tiles) pattern_positions.push_back(positions[tile]);
+        return DescendToGoal(pattern_positions);
+    }
+
+    template <size_t kCells>
+    uint64_t Rank(const std::array<uint8_t, kCells>& positions) const {
+        uint64_t rank = 0;
+        uint64_t used_mask = 0;
+        for (size_t i = 0; i < tiles.size(); ++i) {
+            int current_pos = positions[tiles[i]];
+            int used_below = __builtin_popcountll(used_mask & ((1ULL << current_pos) - 1));
+            rank += (current_pos - used_below) * multipliers[i];
+            used_mask |= 1ULL << current_pos;
+        }
+        return rank;
+    }
+
+private:
+    uint8_t DescendToGoal(std::vector<int> pattern_positions) const;
+
+    template <size_t kCells>
+    uint8_t DeltaValue(uint64_t rank, const std::array<uint8_t, kCells>& positions) const {
+        const uint64_t block = Index(rank);
+        const uint8_t code = PDBFormat::DeltaSymbol(&table[block * PDBFormat::kDeltaBlockBytes],
+                                                    static_cast<uint32_t>(rank - block * group_size));
+        int distance = 0;
+        for (size_t i = 0; i < tiles.size(); ++i) distance += manhattan[i * cells + positions[tiles[i]]];
+        return static_cast<uint8_t>(distance + 2 * symbols[code]);
+    }
+};
+
+// Sum of disjoint pattern databases. The state tracks every tile's position
+// and each database's value, so a move only re-ranks the databases that own
+// one of the moved tiles. Variant-2 databases store sixths of a move.
+// PrepareChildren ranks every (child, re-ranked database) pair of a node in
+// Ranking lanes and prefetches the entries; FinishChild reads them, by which
+// time the line is usually on its way. Mod databases decode each entry
+// from the value the child inherited from its parent, delta databases add
+// the decoded excess to the pattern's Manhattan distance.
+template <typename Variant>
+class PDBHeuristic {
+public:
+    static const bool kConsistent = false;
+    static const bool kMoveBound = false; // No entry follows from the move without a lookup
+    static const int kMaxDatabases = 8;
+
+    using Board = typename Variant::Board;
+
+    struct State {
+        std::array<uint8_t, Variant::kCells> positions;
+        std::array<uint8_t, kMaxDatabases> values;
+        int sum;
+        uint32_t pending;                          // Databases whose entry is not read yet
+        std::array<uint64_t, kMaxDatabases> ranks; // Their ranks (beyond 2^32 for 8-tile patterns on 5x5)
+    };
+
+    explicit PDBHeuristic(const std::vector<PatternDatabase>* databases)
+        : databases(databases), database_mask{}, max_tiles(0), batch_ranking(true) {
+        for (size_t d = 0; d < databases->size(); ++d) {
+            for (int tile : (*databases)[d].tiles) database_mask[tile] |= 1u << d;
+            max_tiles = std::max(max_tiles, static_cast<int>((*databases)[d].tiles.size()));
+            if (!(*databases)[d].tiles.empty() && (*databases)[d].multipliers[0] > UINT32_MAX) batch_ranking = false;
+            if (Variant::kNumber != 1 && (*databases)[d].VariantOneOnly()) {
+                throw std::invalid_argument(std::string(PDBFormat::ToString((*databases)[d].encoding)) +
+                                            " pattern databases are variant 1 only");
+            }
+        }
+    }
+
+    // Mod entries decode from the parent's value, so Root() descends to the
+    // goal for each of them
+    bool HasMod() const {
+        for (const auto& database : *databases) {
+            if (database.Mod()) return true;
+        }
+        return false;
+    }
+
+    State Root(const Board& board) const {
+        State state{};
+        for (int p = 0; p < Variant::kCells; ++p) state.positions[board.tiles[p]] = p;
+        for (size_t d = 0; d < databases->size(); ++d) {
+            state.values[d] = (*databases)[d].RootValue(state.positions);
+            state.sum += state.values[d];
+        }
+        return state;
+    }
+
+    State Child(const State& parent, const Board& board, const Move& move) const {
+        State child;
+        uint32_t dirty = MoveTiles(parent, board, move, child);
+        while (dirty) {
+            int d = __builtin_ctz(dirty);
+            dirty &= dirty - 1;
+            const PatternDatabase& database = (*databases)[d];
+            child.sum -= child.values[d];
+            child.values[d] = database.ChildValue(child.values[d], database.Rank(child.positions), child.positions);
+            child.sum += child.values[d];
+        }
+        return child;
+    }
+
+    void PrepareChildren(const State& parent, const Board& board, const Move* const* moves, int count,
+                         State* children) const {
+        Ranking::Lanes lanes;
+        uint64_t ranks[Ranking::kLanes];
+        uint8_t lane_child[Ranking::kLanes];
+        uint8_t lane_database[Ranking::kLanes];
+        int num_lanes = 0;
+
+        auto rank_lanes = [&] {
+            Ranking::Rank(lanes, max_tiles, (1u << num_lanes) - 1, ranks);
+            for (int lane = 0; lane < num_lanes; ++lane) {
+                State& child = children[lane_child[lane]];
+                const int d = lane_database[lane];
+                child.ranks[d] = ranks[lane];
+                __builtin_prefetch((*databases)[d].EntryAddress(ranks[lane]));
+            }
+            num_lanes = 0;
+        };
+
+        for (int c = 0; c < count; ++c) {
+            uint32_t dirty = MoveTiles(parent, board, *moves[c], children[c]);
+            children[c].pending = dirty;
+            while (dirty) {
+                int d = __builtin_ctz(dirty);
+                dirty &= dirty - 1;
+                const PatternDatabase& database = (*databases)[d];
+                if (!batch_ranking) {
+                    children[c].ranks[d] = database.Rank(children[c].positions);
+                    __builtin_prefetch(database.EntryAddress(children[c].ranks[d]));
+                    continue;
+                }
+                const int num_tiles = static_cast<int>(database.tiles.size());
+                for (int i = 0; i < num_tiles; ++i) {
+                    lanes.positions[i][num_lanes] = children[c].positions[database.tiles[i]];
+                    lanes.multipliers[i][num_lanes] = static_cast<uint32_t>(database.multipliers[i]);
+                }
+                for (int i = num_tiles; i < max_tiles; ++i) {
+                    lanes.positions[i][num_lanes] = 0;
+                    lanes.multipliers[i][num_lanes] = 0;
+                }
+                lane_child[num_lanes] = static_cast<uint8_t>(c);
+                lane_database[num_lanes] = static_cast<uint8_t>(d);
+                if (++num_lanes == Ranking::kLanes) rank_lanes();
+            }
+        }
+        if (num_lanes > 0) rank_lanes();
+    }
+
+    void FinishChild(State& child) const {
+        while (child.pending) {
+            int d = __builtin_ctz(child.pending);
+            child.pending &= child.pending - 1;
+            child.sum -= child.values[d];
+            child.values[d] = (*databases)[d].ChildValue(child.values[d], child.ranks[d], child.positions);
+            child.sum += child.values[d];
+        }
+    }
+
+    int Value(const State& state) const {
+        return (Variant::kNumber == 1) ? state.sum : (state.sum + 5) / 6;
+    }
+
+private:
+    const std::vector<PatternDatabase>* databases;
+    std::array<uint32_t, Variant::kCells> database_mask; // Databases owning each tile
+    int max_tiles;                          // Ranking rows: the largest pattern
+    bool batch_ranking;                     // Multipliers fit the 32-bit Ranking lanes; else ranked one at a time
+
+    // Copies parent into child with the move's tiles shifted; returns the
+    // databases owning a moved tile
+    uint32_t MoveTiles(const State& parent, const Board& board, const Move& move, State& child) const {
+        child = parent;
+        child.pending = 0;
+        uint32_t dirty = 0;
+        for (int p = move.from + move.step; ; p += move.step) {
+            int tile = board.tiles[p];
+            child.positions[tile] = p - move.step;
+            dirty |= database_mask[tile];
+            if (p == move.target) break;
+        }
+        child.positions[0] = move.target;
+        return dirty;
+    }
+};
+
+#endif // HEURISTIC_H
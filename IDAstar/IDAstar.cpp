@@ -0,0 +1,362 @@
+#include "IDAstar.h"
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+template <typename Variant, typename Heuristic>
+IDAstar<Variant, Heuristic>::IDAstar(const Heuristic& heuristic, const MovePruningFSM* move_pruning,
+                                     TranspositionTable* transposition_table, WorkerCounters* counters)
+    : heuristic(heuristic), move_pruning(kFifteenPuzzle ? move_pruning : nullptr),
+      transposition_table(kFifteenPuzzle ? transposition_table : nullptr),
+      counters(counters), board{}, h_state{}, node_h(0), fsm_state(MovePruningFSM::kStart),
+      tt_search_id(0), nodes_expanded(0), nodes_generated(0), budget_check_at(0), node_limit(0),
+      status(SolveStatus::Exhausted), lower_bound(0), stopped_min(Checkpoint::kNoFrontier), replay_failed(false) {}
+
+// Called once nodes_expanded reaches budget_check_at. Schedules the next
+// check no later than the node limit and reads the clock and the token at
+// most once per SearchLimits::kCheckInterval expansions.
+template <typename Variant, typename Heuristic>
+bool IDAstar<Variant, Heuristic>::LimitReached() {
+    if (limits.max_nodes > 0 && nodes_expanded >= node_limit) {
+        status = SolveStatus::NodeLimit;
+        return true;
+    }
+    if (limits.cancel && limits.cancel->IsCancelled()) {
+        status = SolveStatus::Cancelled;
+        return true;
+    }
+    if (limits.max_seconds > 0.0 && std::chrono::steady_clock::now() >= deadline) {
+        status = SolveStatus::TimeLimit;
+        return true;
+    }
+    if (limits.cancel || limits.max_seconds > 0.0) {
+        budget_check_at = nodes_expanded + SearchLimits::kCheckInterval;
+        if (limits.max_nodes > 0) budget_check_at = std::min(budget_check_at, node_limit);
+    } else {
+        budget_check_at = node_limit;
+    }
+    return false;
+}
+
+template <typename Variant, typename Heuristic>
+template <bool kResume>
+int IDAstar<Variant, Heuristic>::Search(int g, int bound) {
+    if (kResume && path.size() == resume_path.size()) {
+        // The node the stopped search was about to expand: search it in full
+        return Search<false>(g, bound);
+    }
+    if (board.IsGoal()) {
+        return -1;
+    }
+    if (nodes_expanded >= budget_check_at && LimitReached()) {
+        return kStopped;
+    }
+
+    // Transposition cutoff: this state was already searched with a lower or
+    // equal g and its subtree proved f > bound from here
+    uint64_t tt_key = 0;
+    if constexpr (kFifteenPuzzle) {
+        if (transposition_table) {
+            tt_key = TranspositionTable::PackState(board.tiles);
+            TranspositionTable::Entry entry;
+            stats.tt_probes++;
+            if (transposition_table->Probe(tt_key, entry) && entry.search_id == tt_search_id &&
+                entry.g <= g && g + entry.h_bound > bound) {
+                stats.tt_hits++;
+                return g + entry.h_bound;
+            }
+        }
+    }
+
+    // A node past the goal, budget and transposition checks is expanded; each
+    // child evaluated below counts as generated, searched or not
+    nodes_expanded++;
+
+    // Publish progress for the telemetry reporter (no I/O in the search loop)
+    if (counters && nodes_expanded % WorkerCounters::kPublishInterval == 0) {
+        counters->Publish(nodes_expanded, nodes_generated, g);
+    }
+
+    int min_cost = std::numeric_limits<int>::max();
+    int parent_h = node_h;
+
+    // Enhanced partial expansion: with Manhattan and WD a lower bound on a
+    // child's h follows from its move, so children it puts beyond the bound
+    // only lower the next threshold and are never generated or evaluated. The
+    // rest are bucketed by f-delta, which orders them without sorting (deltas
+    // are 0-2 for consistent heuristics).
+    ChildBuckets<Child, Variant::kMaxChildren, Heuristic::kConsistent ? 4 : 8> children;
+
+    // Evaluate the children in two passes: PrepareChildren (or PrepareBounded,
+    // completing the states the move bound started) applies every surviving
+    // move to the heuristic state, ranking the children together and
+    // prefetching their table entries; the second pass reads them. The lookups
+    // of all children are then in flight together instead of each one
+    // stalling the next.
+    const Move* batch_moves[Variant::kMaxChildren] = {};
+    HeuristicState batch_states[Variant::kMaxChildren];
+    int batch_size = 0;
+    const MoveList& moves = Variant::Moves(board.blank);
+    for (int i = 0; i < moves.size; ++i) {
+        const Move& move = moves.moves[i];
+
+        // Prune duplicates (the FSM also covers the reverse move)
+        if (move_pruning) {
+            if (move_pruning->Next(fsm_state, move.action) == MovePruningFSM::kPruned) continue;
+        } else if (!path.empty() && move.action.dir == Opposite(path.back().dir)) {
+            continue;
+        }
+
+        if constexpr (Heuristic::kMoveBound) {
+            const int f = g + Variant::Cost(move) + heuristic.MoveBound(h_state, board, move, batch_states[batch_size]);
+            if (f > bound) {
+                if (f < min_cost) min_cost = f;
+                continue;
+            }
+        }
+
+        batch_moves[batch_size++] = &move;
+        stats.heuristic_evals++;
+    }
+    if constexpr (Heuristic::kMoveBound) {
+        heuristic.PrepareBounded(h_state, board, batch_moves, batch_size, batch_states);
+    } else {
+        heuristic.PrepareChildren(h_state, board, batch_moves, batch_size, batch_states);
+    }
+    nodes_generated += batch_size;
+
+    for (int i = 0; i < batch_size; ++i) {
+        Child child{batch_moves[i], batch_states[i], 0};
+        const Move& move = *child.move;
+        heuristic.FinishChild(child.h_state);
+        child.h = heuristic.Value(child.h_state);
+        const int cost = Variant::Cost(move);
+
+        // BPMX: with an inconsistent heuristic a child's h minus the edge cost
+        // can exceed the parent's h. Raise the parent's h and cut it off once
+        // it alone exceeds the bound; every child then has f >= g + h by
+        // pathmax and the loop below expands none of them.
+        if (!Heuristic::kConsistent && child.h - cost > parent_h) {
+            parent_h = child.h - cost;
+            if (g + parent_h > bound) {
+                min_cost = g + parent_h;
+                break;
+            }
+        }
+
+        int f = g + cost + child.h;
+        if (f > bound) {
+            if (f < min_cost) min_cost = f;
+            continue;
+        }
+        children.Add(child, f - (g + parent_h));
+    }
+
+    Child child;
+    bool replaying = kResume;
+    while (children.Pop(child)) {
+        const Move& move = *child.move;
+        const int cost = Variant::Cost(move);
+
+        // Children before the one on the resume path were searched before the
+        // checkpoint; their f values are part of the saved frontier minimum
+        if (kResume && replaying) {
+            const Action& next = resume_path[path.size()];
+            if (move.action.dir != next.dir || move.action.steps != next.steps) continue;
+        }
+
+        // Pathmax: a child's h is at least the parent's h minus the edge cost
+        int child_h = child.h;
+        if (!Heuristic::kConsistent) {
+            child_h = std::max(child_h, parent_h - cost);
+            if (g + cost + child_h > bound) {
+                if (g + cost + child_h < min_cost) min_cost = g + cost + child_h;
+                continue;
+            }
+        }
+
+        const HeuristicState parent_state = h_state;
+        const int parent_node_h = node_h;
+        const int parent_fsm = fsm_state;
+        if (move_pruning) {
+            fsm_state = move_pruning->Next(parent_fsm, move.action);
+        }
+        h_state = child.h_state;
+        node_h = child_h;
+        board.Apply(move);
+        path.push_back(move.action);
+
+        int t;
+        if (kResume && replaying) {
+            replaying = false;
+            t = Search<true>(g + cost, bound);
+        } else {
+            t = Search<false>(g + cost, bound);
+        }
+
+        if (t == -1) {
+            return -1;
+        }
+        if (t == kStopped) {
+            // Keep the path as the DFS position; remember what this node finished
+            if (min_cost < stopped_min) stopped_min = min_cost;
+            return kStopped;
+        }
+        if (t < min_cost) min_cost = t;
+
+        path.pop_back();
+        board.Undo(move);
+        h_state = parent_state;
+        node_h = parent_node_h;
+        fsm_state = parent_fsm;
+    }
+
+    if (kResume && replaying) {
+        replay_failed = true;
+    }
+
+    // A replayed node skipped some children, so its min_cost is not a bound
+    if (transposition_table && !kResume) {
+        int h_bound = (min_cost == std::numeric_limits<int>::max()) ? TranspositionTable::kMaxValue : min_cost - g;
+        transposition_table->Store(tt_key, tt_search_id, g, h_bound);
+    }
+
+    return min_cost;
+}
+
+template <typename Variant, typename Heuristic>
+std::tuple<std::vector<Action>, int, double, long long, long long, typename Variant::Puzzle> IDAstar<Variant, Heuristic>::Solve(
+    Puzzle& puzzle, IterationCallback callback, int core_num, std::ofstream& outfile, const SearchLimits& limits,
+    const Checkpoint* resume, CheckpointCallback checkpoint) {
+    auto start = std::chrono::high_resolution_clock::now();
+
+    board.tiles = puzzle.GetTiles();
+    const auto [blank_row, blank_col] = puzzle.GetBlankPosition();
+    board.blank = blank_row * Variant::kCols + blank_col;
+    h_state = heuristic.Root(board);
+    int bound = heuristic.Value(h_state);
+    node_h = bound;
+    fsm_state = MovePruningFSM::kStart;
+    if (transposition_table) {
+        tt_search_id = transposition_table->NewSearch();
+    }
+    path.clear();
+    resume_path.clear();
+    nodes_expanded = 0;
+    nodes_generated = 0;
+
+    int iteration = 0;
+    int resume_min = Checkpoint::kNoFrontier;
+    double elapsed_before = 0.0;
+    if (resume && std::equal(resume->tiles.begin(), resume->tiles.end(), board.tiles.begin(), board.tiles.end()) &&
+        !resume->solved) {
+        // Every bound below the saved one is exhausted
+        bound = std::max(bound, resume->bound);
+        resume_path = resume->path;
+        resume_min = resume->frontier_min;
+        iteration = resume->iterations;
+        nodes_expanded = resume->nodes_expanded;
+        nodes_generated = resume->nodes_generated;
+        elapsed_before = resume->elapsed;
+    }
+
+    this->limits = limits;
+    deadline = std::chrono::steady_clock::now() +
+               std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(limits.max_seconds));
+    node_limit = nodes_expanded + limits.max_nodes;
+    budget_check_at = limits.Unlimited() ? std::numeric_limits<long long>::max() : 0;
+
+    auto elapsed = [&]() {
+        std::chrono::duration<double> time = std::chrono::high_resolution_clock::now() - start;
+        return elapsed_before + time.count();
+    };
+    auto report = [&](bool solved, int next_bound, int frontier_min, bool with_position, double time) {
+        if (!checkpoint) return;
+        Checkpoint progress;
+        progress.tiles.assign(board.tiles.begin(), board.tiles.end());
+        progress.solved = solved;
+        progress.bound = next_bound;
+        progress.frontier_min = frontier_min;
+        if (with_position) progress.path = path;
+        progress.iterations = iteration;
+        progress.nodes_expanded = nodes_expanded;
+        progress.nodes_generated = nodes_generated;
+        progress.elapsed = time;
+        checkpoint(progress);
+    };
+
+    while (true) {
+        if (counters) counters->NewIteration(bound);
+        stats = IterationStats();
+        stats.iteration = iteration + 1;
+        stats.bound = bound;
+        const long long expanded_before = nodes_expanded;
+        const long long generated_before = nodes_generated;
+        auto iteration_start = std::chrono::high_resolution_clock::now();
+
+        stopped_min = Checkpoint::kNoFrontier;
+        replay_failed = false;
+        int t = resume_path.empty() ? Search<false>(0, bound) : Search<true>(0, bound);
+        if (replay_failed && t != kStopped && t != -1) {
+            // The saved position is not in this search tree (e.g. another
+            // move pruning table); repeat the iteration from the root
+            resume_path.clear();
+            resume_min = Checkpoint::kNoFrontier;
+            continue;
+        }
+        if (t == kStopped) {
+            // The unfinished iteration is not reported; its bound stays the
+            // lower bound and the checkpoint keeps the position inside it
+            lower_bound = bound;
+            const double total = elapsed();
+            report(false, bound, std::min(stopped_min, resume_min), true, total);
+            path.clear();
+            return {{}, -1, total, nodes_expanded, nodes_generated, puzzle};
+        }
+        // Subtrees skipped while replaying count towards the next bound
+        if (t != -1 && resume_min < t) t = resume_min;
+        resume_path.clear();
+        resume_min = Checkpoint::kNoFrontier;
+        ++iteration;
+
+        std::chrono::duration<double> iteration_time = std::chrono::high_resolution_clock::now() - iteration_start;
+        stats.wall_time = iteration_time.count();
+        stats.nodes_expanded = nodes_expanded - expanded_before;
+        stats.nodes_generated = nodes_generated - generated_before;
+        stats.solved = (t == -1);
+        callback(core_num, stats, outfile);
+
+        if (t == -1) {
+            status = SolveStatus::Solved;
+            lower_bound = static_cast<int>(path.size());
+            const double total = elapsed();
+            report(true, lower_bound, Checkpoint::kNoFrontier, false, total);
+            for (const auto& action : path) puzzle.ApplyAction(action);
+            return {path, static_cast<int>(path.size()), total, nodes_expanded, nodes_generated, puzzle};
+        }
+        if (t == std::numeric_limits<int>::max()) break;
+        bound = t;
+        report(false, bound, Checkpoint::kNoFrontier, false, elapsed());
+    }
+    status = SolveStatus::Exhausted;
+    lower_bound = bound;
+    return {{}, -1, elapsed(), nodes_expanded, nodes_generated, puzzle};
+}
+
+// The supported combinations; each compiles to its own specialized search loop
+template class IDAstar<Variant1, ManhattanHeuristic<Variant1>>;
+template class IDAstar<Variant1, WalkingDistanceHeuristic<Variant1>>;
+template class IDAstar<Variant1, PDBHeuristic<Variant1>>;
+template class IDAstar<Variant2, ManhattanHeuristic<Variant2>>;
+template class IDAstar<Variant2, WalkingDistanceHeuristic<Variant2>>;
+template class IDAstar<Variant2, PDBHeuristic<Variant2>>;
+
+// The 8- and 24-puzzle (no walking distance tables for them)
+template class IDAstar<Variant<1, 3, 3>, ManhattanHeuristic<Variant<1, 3, 3>>>;
+template class IDAstar<Variant<1, 3, 3>, PDBHeuristic<Variant<1, 3, 3>>>;
+template class IDAstar<Variant<2, 3, 3>, ManhattanHeuristic<Variant<2, 3, 3>>>;
+template class IDAstar<Variant<2, 3, 3>, PDBHeuristic<Variant<2, 3, 3>>>;
+template class IDAstar<Variant<1, 5, 5>, ManhattanHeuristic<Variant<1, 5, 5>>>;
+template class IDAstar<Variant<1, 5, 5>, PDBHeuristic<Variant<1, 5, 5>>>;
+template class IDAstar<Variant<2, 5, 5>, ManhattanHeuristic<Variant<2, 5, 5>>>;
+template class IDAstar<Variant<2, 5, 5>, PDBHeuristic<Variant<2, 5, 5>>>;
@@ -0,0 +1,102 @@
+#ifndef IDASTAR_H
+#define IDASTAR_H
+
+#include "Checkpoint.h"
+#include "Heuristic.h"
+#include "Variant.h"
+#include "../Puzzle/Puzzle.h"
+#include "../Search/ChildBuckets.h"
+#include "../Search/IterationStats.h"
+#include "../Search/MovePruningFSM.h"
+#include "../Search/SearchLimits.h"
+#include "../Search/Telemetry.h"
+#include "../Search/TranspositionTable.h"
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <tuple>
+#include <vector>
+
+using IterationCallback = std::function<void(int, const IterationStats&, std::ofstream&)>; // Called after every iteration
+using CheckpointCallback = std::function<void(const Checkpoint&)>; // Called after every iteration and when a solve stops
+
+// IDA* specialized at compile time on the puzzle variant (move set, cost
+// model and board size) and the heuristic. The inner loop walks a precomputed move table and
+// updates the heuristic state per move; no per-node variant checks, hashing
+// or allocation. Explicit instantiations live in IDAstar.cpp.
+//
+// A solve can be bounded by SearchLimits. A stopped solve returns no path;
+// Status() tells why and LowerBound() keeps what the finished iterations
+// proved. With a checkpoint callback the solver reports its progress after
+// every iteration and its DFS position when stopped; passing that checkpoint
+// back resumes the search from it.
+//
+// The move pruning automata and the transposition table's packed keys
+// describe the 15-puzzle; on other boards both are ignored.
+template <typename Variant, typename Heuristic>
+class IDAstar {
+public:
+    using Puzzle = typename Variant::Puzzle;
+
+private:
+    using HeuristicState = typename Heuristic::State;
+
+    static const bool kFifteenPuzzle = (Variant::kRows == 4 && Variant::kCols == 4);
+
+    static const int kStopped = -2;          // Search() result when a limit was hit
+
+    struct Child {
+        const Move* move;
+        HeuristicState h_state;
+        int h;
+    };
+
+    const Heuristic& heuristic;              // Shared read-only across solver threads
+    const MovePruningFSM* move_pruning;      // Optional duplicate-pruning automaton (nullptr: reverse-move pruning only)
+    TranspositionTable* transposition_table; // Optional shared transposition table (nullptr disables it)
+    WorkerCounters* counters;                // Optional progress counters sampled by the telemetry reporter
+
+    // State of the node being expanded, saved and restored around recursion
+    typename Variant::Board board;
+    HeuristicState h_state;
+    int node_h;                              // h, raised by pathmax for inconsistent heuristics
+    int fsm_state;                           // Automaton state
+    std::vector<Action> path;
+
+    uint32_t tt_search_id;                   // Tags this solve's entries in the shared table
+    long long nodes_expanded;
+    long long nodes_generated;
+    IterationStats stats;                    // Counters of the current iteration
+
+    SearchLimits limits;
+    std::chrono::steady_clock::time_point deadline;
+    long long budget_check_at;               // nodes_expanded at which the limits are checked next
+    long long node_limit;                    // max_nodes past the resumed node count
+    SolveStatus status;
+    int lower_bound;
+
+    std::vector<Action> resume_path;         // DFS position being replayed
+    int stopped_min;                         // Smallest f beyond the bound in the finished part of a stopped iteration
+    bool replay_failed;                      // A move on resume_path was not among the children
+
+    // kResume: the node lies on resume_path, so the children ordered before
+    // the next move on the path are skipped
+    template <bool kResume>
+    int Search(int g, int bound);
+    bool LimitReached();
+
+public:
+    explicit IDAstar(const Heuristic& heuristic, const MovePruningFSM* move_pruning = nullptr,
+                     TranspositionTable* transposition_table = nullptr, WorkerCounters* counters = nullptr);
+    std::tuple<std::vector<Action>, int, double, long long, long long, Puzzle> Solve(Puzzle& puzzle, IterationCallback, int, std::ofstream&,
+                                                                                     const SearchLimits& limits = SearchLimits(),
+                                                                                     const Checkpoint* resume = nullptr,
+                                                                                     CheckpointCallback checkpoint = nullptr);
+
+    SolveStatus Status() const { return status; }
+    // Optimal solution length once solved; otherwise the bound of the
+    // unfinished iteration, which every exhausted bound below it proves
+    int LowerBound() const { return lower_bound; }
+};
+
+#endif // IDASTAR_H
@@ -0,0 +1,88 @@
+#include "InstanceStream.h"
+#include "../Puzzle/Puzzle.h"
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+bool ParseInstance(const std::string& line, int default_id, Instance& instance) {
+    size_t first = line.find_first_not_of(" \t\r");
+    if (first == std::string::npos || line[first] == '#') return false;
+
+    std::istringstream iss(line);
+    std::vector<long long> values;
+    long long value;
+    while (iss >> value) values.push_back(value);
+    if (!iss.eof()) {
+        throw std::invalid_argument("non-numeric token");
+    }
+
+    size_t offset;
+    if (values.size() == 17) {
+        instance.id = static_cast<int>(values[0]);
+        offset = 1;
+    } else if (values.size() == 16) {
+        instance.id = default_id;
+        offset = 0;
+    } else {
+        throw std::invalid_argument("expected 16 tiles, optionally preceded by an id");
+    }
+    for (int i = 0; i < 16; ++i) {
+        long long tile = values[offset + i];
+        instance.tiles[i] = (tile >= 0 && tile <= 15) ? static_cast<int>(tile) : -1;
+    }
+    if (!Puzzle::IsSolvable(instance.tiles)) {
+        throw std::invalid_argument("not a solvable permutation of 0-15");
+    }
+    return true;
+}
+
+InstanceQueue::InstanceQueue(size_t capacity) : capacity(capacity > 0 ? capacity : 1), closed(false) {}
+
+bool InstanceQueue::Push(const Instance& instance) {
+    std::unique_lock<std::mutex> lock(mutex);
+    not_full.wait(lock, [this] { return instances.size() < capacity || closed; });
+    if (closed) return false;
+    instances.push_back(instance);
+    not_empty.notify_one();
+    return true;
+}
+
+bool InstanceQueue::Pop(Instance& instance) {
+    std::unique_lock<std::mutex> lock(mutex);
+    not_empty.wait(lock, [this] { return !instances.empty() || closed; });
+    if (instances.empty()) return false;
+    instance = instances.front();
+    instances.pop_front();
+    not_full.notify_one();
+    return true;
+}
+
+void InstanceQueue::Close() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        closed = true;
+    }
+    not_empty.notify_all();
+    not_full.notify_all();
+}
+
+long long ReadInstances(std::istream& in, const std::string& source, int& next_id, InstanceQueue& queue) {
+    long long count = 0;
+    long long line_num = 0;
+    std::string line;
+    while (std::getline(in, line)) {
+        ++line_num;
+        Instance instance;
+        try {
+            if (!ParseInstance(line, next_id, instance)) continue;
+        } catch (const std::invalid_argument& e) {
+            std::cerr << source << ":" << line_num << ": skipped (" << e.what() << ")\n";
+            continue;
+        }
+        ++next_id;
+        if (!queue.Push(instance)) break;
+        ++count;
+    }
+    return count;
+}
@@ -0,0 +1,49 @@
+#ifndef INSTANCE_STREAM_H
+#define INSTANCE_STREAM_H
+
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <istream>
+#include <mutex>
+#include <string>
+
+// One puzzle instance from an instance file
+struct Instance {
+    int id;
+    std::array<int, 16> tiles;
+};
+
+// Parses one line of an instance file. Accepted formats are korf100's
+// "id t0 ... t15" and plain "t0 ... t15" (the instance then gets
+// `default_id`). Returns false for blank lines and '#' comments; throws
+// std::invalid_argument for malformed or unsolvable instances.
+bool ParseInstance(const std::string& line, int default_id, Instance& instance);
+
+// Bounded queue between the reader and the solver threads. The reader blocks
+// once `capacity` instances are waiting, so memory stays flat no matter how
+// large the input is, and workers start as soon as the first line is parsed.
+class InstanceQueue {
+public:
+    explicit InstanceQueue(size_t capacity);
+
+    bool Push(const Instance& instance); // False once the queue is closed
+    bool Pop(Instance& instance); // False once the queue is closed and drained
+    void Close();
+
+private:
+    std::deque<Instance> instances;
+    size_t capacity;
+    bool closed;
+    std::mutex mutex;
+    std::condition_variable not_empty;
+    std::condition_variable not_full;
+};
+
+// Reads all instances from `in` into `queue`, numbering unnumbered lines
+// from `next_id`. Malformed lines are reported to std::cerr and skipped.
+// Stops early if the queue is closed. Returns the number of instances queued.
+long long ReadInstances(std::istream& in, const std::string& source, int& next_id, InstanceQueue& queue);
+
+#endif // INSTANCE_STREAM_H
@@ -0,0 +1,65 @@
+#include "SolveRequest.h"
+#include <sstream>
+#include <stdexcept>
+
+void ParseSolveRequest(const std::string& arguments, SolveRequest& request) {
+    std::istringstream iss(arguments);
+    if (!(iss >> request.tag)) throw std::invalid_argument("missing tag");
+
+    // key=value options first, then the instance
+    std::string token;
+    std::string tiles;
+    while (iss >> token) {
+        const size_t equals = token.find('=');
+        if (equals == std::string::npos) {
+            tiles += token + ' ';
+            continue;
+        }
+        const std::string key = token.substr(0, equals);
+        const std::string value = token.substr(equals + 1);
+        if (key == "heuristic") {
+            request.heuristic = value;
+            continue;
+        }
+        if (key == "engine") {
+            request.engine = value;
+            continue;
+        }
+        if (key != "variant" && key != "max-nodes" && key != "max-time") {
+            throw std::invalid_argument("unknown option " + key);
+        }
+        size_t used = 0;
+        try {
+            if (key == "variant") {
+                request.variant = std::stoi(value, &used);
+            } else if (key == "max-nodes") {
+                request.max_nodes = std::stoll(value, &used);
+            } else {
+                request.max_time = std::stod(value, &used);
+            }
+        } catch (const std::logic_error&) { // invalid_argument or out_of_range
+            used = 0;
+        }
+        if (used == 0 || used != value.size()) throw std::invalid_argument("bad value for " + key);
+    }
+    if (request.variant != 1 && request.variant != 2) throw std::invalid_argument("variant must be 1 or 2");
+    if (request.heuristic != "md" && request.heuristic != "wd" && request.heuristic != "pdb") {
+        throw std::invalid_argument("heuristic must be md, wd or pdb");
+    }
+    if (request.engine != "idastar" && request.engine != "astar") {
+        throw std::invalid_argument("engine must be idastar or astar");
+    }
+    if (request.max_nodes < 0 || request.max_time < 0.0) throw std::invalid_argument("limits must not be negative");
+    if (!ParseInstance(tiles, 0, request.instance)) throw std::invalid_argument("missing tiles");
+}
+
+std::string FormatPath(const std::vector<Action>& path) {
+    static const char kDirections[] = {'L', 'R', 'U', 'D'};
+    std::string text;
+    for (const Action& action : path) {
+        if (!text.empty()) text += ',';
+        text += kDirections[action.dir];
+        text += std::to_string(action.steps);
+    }
+    return text;
+}
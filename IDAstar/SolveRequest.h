@@ -0,0 +1,48 @@
+#ifndef SOLVE_REQUEST_H
+#define SOLVE_REQUEST_H
+
+#include "InstanceStream.h"
+#include "../Puzzle/Puzzle.h"
+#include <string>
+#include <vector>
+
+// Line protocol of SolverDaemon. A client sends one command per line:
+//
+//   solve <tag> [variant=1|2] [heuristic=md|wd|pdb] [engine=idastar|astar]
+//         [max-nodes=<n>] [max-time=<s>] t0 ... t15
+//   stats
+//   quit
+//
+// and reads lines back, each naming the tag of the solve it belongs to:
+//
+//   queued <tag> <position>
+//   iteration <tag> <bound> <expanded> <generated> <seconds>
+//   fallback <tag> <bound> <expanded> <generated> <seconds>
+//   solved <tag> <length> <expanded> <generated> <seconds> <path>
+//   stopped <tag> <status> <lower bound> <expanded> <generated> <seconds>
+//   error <tag> <message>
+//
+// The path lists the blank's moves as L, R, U or D with the tiles moved,
+// e.g. L1,U2,R1 (variant 2 moves slide up to three tiles). A client may keep
+// several solves in flight; their lines interleave. With engine=astar the
+// iterations are A*'s f-layers; a fallback line says A* reached its memory
+// cap and IDA* continues from the bound, its counts including A*'s.
+struct SolveRequest {
+    std::string tag;
+    int variant = 1;
+    std::string heuristic = "wd";  // md, wd or pdb
+    std::string engine = "idastar"; // idastar or astar
+    long long max_nodes = 0;       // 0: the daemon's limit
+    double max_time = 0.0;
+    Instance instance;
+};
+
+// Parses the arguments of a solve line (after "solve"); unset fields keep
+// the values in `request`. Throws std::invalid_argument with a message for
+// the client on malformed requests.
+void ParseSolveRequest(const std::string& arguments, SolveRequest& request);
+
+// "L1,U2,R1"
+std::string FormatPath(const std::vector<Action>& path);
+
+#endif // SOLVE_REQUEST_H
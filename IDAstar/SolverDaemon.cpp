@@ -0,0 +1,671 @@
+#include "Astar.h"
+#include "IDAstar.h"
+#include "SolveRequest.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <cstring>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// Long-lived solver service. The heuristic tables and move pruning automata
+// are loaded once at startup and a pool of workers, each holding one solver
+// per variant and heuristic, stays warm between requests; clients connect to
+// a Unix domain socket and submit instances with the line protocol of
+// SolveRequest.h. Iterations and results are streamed back as they happen.
+//
+//   SolverDaemon --socket /tmp/stp.sock --pdb-v1 pdb_a.bin "{1,2,3,4,5,6}" ...
+//   echo "solve a heuristic=pdb 14 13 15 7 11 12 9 5 6 0 2 1 4 8 10 3" | socat - UNIX-CONNECT:/tmp/stp.sock
+//
+// A client that closes its side still gets the lines of the solves it
+// submitted; "quit", a failed write, a client that stops taking its output
+// or SIGINT/SIGTERM cancel them.
+
+// Set by the first SIGINT/SIGTERM; a second signal terminates at once
+CancellationToken stop_token;
+
+extern "C" void HandleStopSignal(int signal) {
+    stop_token.Cancel();
+    std::signal(signal, SIG_DFL);
+}
+
+struct Options {
+    std::string socket_path = "/tmp/stp_solver.sock";
+    int num_threads = 0;                              // 0: one per hardware thread
+    std::string heuristic = "wd";                     // Default of requests without heuristic=
+    std::string engine = "idastar";                   // Default of requests without engine=
+    size_t astar_memory_mb = 1024;                    // Per worker, then IDA* takes over
+    std::vector<std::string> pdb_files[2];            // Per variant
+    std::vector<std::vector<int>> patterns[2];
+    std::string wd_file = "../Heuristics/wd_table.bin";
+    bool move_pruning = true;                         // ../Search/fsm_v<variant>.bin
+    long long max_nodes = 0;                          // Per request ceiling, 0: unlimited
+    double max_time = 0.0;
+    size_t max_queued = 1024;                         // Requests waiting for a worker
+    double report_interval = 0.0;                     // Telemetry on stdout, 0: off
+};
+
+void PrintUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [options]\n"
+              << "  --socket <path>                Unix domain socket to listen on (default /tmp/stp_solver.sock)\n"
+              << "  --threads <n>                  Solver workers (default: hardware threads)\n"
+              << "  --heuristic md|wd|pdb          Heuristic of requests that name none (default wd)\n"
+              << "  --engine idastar|astar         Engine of requests that name none (default idastar)\n"
+              << "  --astar-memory <mb>            A* closed table and open list per worker (default 1024)\n"
+              << "  --pdb-v1 <file> <pattern>      Variant-1 pattern database and its tiles; repeat per PDB\n"
+              << "  --pdb-v2 <file> <pattern>      Variant-2 pattern database and its tiles; repeat per PDB\n"
+              << "  --wd <file>                    Walking distance table (default ../Heuristics/wd_table.bin)\n"
+              << "  --no-fsm                       Reverse-move pruning only\n"
+              << "  --max-nodes <n>                Expanded node ceiling per request (default 0, unlimited)\n"
+              << "  --max-time <seconds>           Wall clock ceiling per request (default 0, unlimited)\n"
+              << "  --max-queued <n>               Requests waiting for a worker before new ones are refused (default 1024)\n"
+              << "  --report <seconds>             Progress report interval (default 0, off)\n"
+              << "  --huge-pages off|thp|explicit  PDB memory: 4 KB pages, transparent or reserved 2 MB pages (default thp)\n";
+}
+
+std::vector<int> ParsePattern(const std::string& pattern_str) {
+    std::vector<int> pattern;
+    std::string cleaned = pattern_str;
+    if (!cleaned.empty() && cleaned.front() == '{') cleaned = cleaned.substr(1, cleaned.size() - 2);
+    std::istringstream iss(cleaned);
+    std::string token;
+    while (std::getline(iss, token, ',')) {
+        pattern.push_back(std::stoi(token));
+    }
+    return pattern;
+}
+
+void ParseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc) throw std::invalid_argument("missing value for " + arg);
+            return argv[++i];
+        };
+        if (arg == "--socket") {
+            options.socket_path = value();
+        } else if (arg == "--threads") {
+            options.num_threads = std::stoi(value());
+        } else if (arg == "--heuristic") {
+            options.heuristic = value();
+        } else if (arg == "--engine") {
+            options.engine = value();
+        } else if (arg == "--astar-memory") {
+            options.astar_memory_mb = std::stoul(value());
+        } else if (arg == "--pdb-v1" || arg == "--pdb-v2") {
+            const int variant = (arg == "--pdb-v1") ? 0 : 1;
+            options.pdb_files[variant].push_back(value());
+            options.patterns[variant].push_back(ParsePattern(value()));
+        } else if (arg == "--wd") {
+            options.wd_file = value();
+        } else if (arg == "--no-fsm") {
+            options.move_pruning = false;
+        } else if (arg == "--max-nodes") {
+            options.max_nodes = std::stoll(value());
+        } else if (arg == "--max-time") {
+            options.max_time = std::stod(value());
+        } else if (arg == "--max-queued") {
+            options.max_queued = std::stoul(value());
+        } else if (arg == "--report") {
+            options.report_interval = std::stod(value());
+        } else if (arg == "--huge-pages") {
+            HugePages::Policy policy;
+            if (!HugePages::ParsePolicy(value(), policy)) throw std::invalid_argument("huge pages must be off, thp or explicit");
+            HugePages::SetPolicy(policy);
+        } else {
+            throw std::invalid_argument("unknown option " + arg);
+        }
+    }
+    if (options.heuristic != "md" && options.heuristic != "wd" && options.heuristic != "pdb") {
+        throw std::invalid_argument("heuristic must be md, wd or pdb");
+    }
+    if (options.engine != "idastar" && options.engine != "astar") {
+        throw std::invalid_argument("engine must be idastar or astar");
+    }
+    if (options.socket_path.size() >= sizeof(sockaddr_un::sun_path)) {
+        throw std::invalid_argument("socket path too long");
+    }
+    if (options.num_threads <= 0) {
+        options.num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+}
+
+// One client, on a non-blocking socket. The main thread reads its requests
+// and holds it until its output is flushed; workers hold it while they owe it
+// lines, and the socket closes with the last holder.
+class Connection {
+public:
+    // A client that accepts none of its pending output for kStallSeconds, or
+    // lets more than kMaxOutput bytes pile up, counts as gone
+    static const int kStallSeconds = 10;
+    static const size_t kMaxOutput = 1 << 22;
+
+    explicit Connection(int fd) : fd(fd) {}
+    ~Connection() { close(fd); }
+    Connection(const Connection&) = delete;
+    Connection& operator=(const Connection&) = delete;
+
+    int Fd() const { return fd; }
+
+    // Queues one line and writes what the socket takes without blocking; the
+    // main thread's poll loop flushes the rest. Once the client is gone its
+    // solves are cancelled and later lines dropped.
+    void Send(const std::string& line) {
+        std::lock_guard<std::mutex> lock(mutex);
+        Append(line);
+    }
+
+    // Sends the line make_line() returns, calling it under the send lock:
+    // lines other threads send meanwhile cannot overtake it
+    template <typename MakeLine>
+    void SendWith(MakeLine make_line) {
+        std::lock_guard<std::mutex> lock(mutex);
+        Append(make_line());
+    }
+
+    // Main thread: on POLLOUT, and to drop a client stalled for too long
+    void Flush() {
+        std::lock_guard<std::mutex> lock(mutex);
+        Write();
+        if (!output.empty() && std::chrono::steady_clock::now() - last_progress > std::chrono::seconds(kStallSeconds)) {
+            Break();
+        }
+    }
+
+    bool HasOutput() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return !output.empty();
+    }
+
+    CancellationToken cancel; // Stops the client's running and queued solves
+    std::string input;        // Bytes after the last complete line (main thread only)
+    bool reading = true;      // Requests still read (main thread only)
+
+private:
+    int fd;
+    std::mutex mutex;
+    std::string output; // Lines the socket has not taken yet
+    std::chrono::steady_clock::time_point last_progress;
+    bool broken = false;
+
+    void Append(const std::string& line) {
+        if (broken) return;
+        if (output.empty()) last_progress = std::chrono::steady_clock::now();
+        output += line;
+        output += '\n';
+        if (output.size() > kMaxOutput) {
+            Break();
+            return;
+        }
+        Write();
+    }
+
+    void Write() {
+        size_t sent = 0;
+        while (!broken && sent < output.size()) {
+            const ssize_t n = send(fd, output.data() + sent, output.size() - sent, MSG_NOSIGNAL | MSG_DONTWAIT);
+            if (n < 0 && errno == EINTR) continue;
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+            if (n <= 0) {
+                Break();
+                return;
+            }
+            sent += static_cast<size_t>(n);
+            last_progress = std::chrono::steady_clock::now();
+        }
+        output.erase(0, sent);
+    }
+
+    void Break() {
+        broken = true;
+        output.clear();
+        cancel.Cancel();
+    }
+};
+
+struct Job {
+    std::shared_ptr<Connection> connection;
+    SolveRequest request;
+    SearchLimits limits;
+    int number = 0; // Daemon-wide, from 1; the worker's telemetry puzzle number (0 means idle)
+};
+
+// Requests waiting for a worker, oldest first. Push refuses new jobs once
+// `capacity` are waiting instead of blocking the reading thread.
+class JobQueue {
+public:
+    explicit JobQueue(size_t capacity) : capacity(capacity > 0 ? capacity : 1) {}
+
+    // Position in the queue (1: next), 0 if full or closed
+    size_t Push(Job job) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (closed || jobs.size() >= capacity) return 0;
+        jobs.push_back(std::move(job));
+        not_empty.notify_one();
+        return jobs.size();
+    }
+
+    // False once the queue is closed
+    bool Pop(Job& job) {
+        std::unique_lock<std::mutex> lock(mutex);
+        not_empty.wait(lock, [this] { return !jobs.empty() || closed; });
+        if (closed) return false;
+        job = std::move(jobs.front());
+        jobs.pop_front();
+        return true;
+    }
+
+    void Close() {
+        std::lock_guard<std::mutex> lock(mutex);
+        closed = true;
+        jobs.clear();
+        not_empty.notify_all();
+    }
+
+    size_t Size() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return jobs.size();
+    }
+
+private:
+    std::deque<Job> jobs;
+    size_t capacity;
+    bool closed = false;
+    std::mutex mutex;
+    std::condition_variable not_empty;
+};
+
+struct ServiceCounters {
+    std::atomic<long long> received{0};
+    std::atomic<long long> solved{0};
+    std::atomic<long long> stopped{0};
+    std::atomic<long long> refused{0};
+    std::atomic<int> active{0};
+};
+
+// Heuristics and move pruning of one variant, shared read-only by all workers
+template <typename Variant>
+struct VariantTables {
+    ManhattanHeuristic<Variant> manhattan;
+    WalkingDistanceHeuristic<Variant> walking_distance;
+    std::vector<PatternDatabase> databases;
+    std::unique_ptr<PDBHeuristic<Variant>> pdb;        // nullptr without databases
+    MovePruningFSM fsm;
+    const MovePruningFSM* move_pruning = nullptr;
+
+    explicit VariantTables(const WalkingDistance* table) : walking_distance(table) {}
+
+    bool Load(const Options& options) {
+        const int v = Variant::kNumber - 1;
+        databases.resize(options.pdb_files[v].size());
+        for (size_t d = 0; d < databases.size(); ++d) {
+            if (!databases[d].Load(options.pdb_files[v][d], options.patterns[v][d], Variant::kNumber)) return false;
+            if (Variant::kNumber != 1 && databases[d].VariantOneOnly()) {
+                std::cerr << options.pdb_files[v][d] << ": " << PDBFormat::ToString(databases[d].encoding)
+                          << " pattern databases are variant 1 only\n";
+                return false;
+            }
+        }
+        if (databases.size() > static_cast<size_t>(PDBHeuristic<Variant>::kMaxDatabases)) {
+            std::cerr << "At most " << PDBHeuristic<Variant>::kMaxDatabases << " pattern databases are supported\n";
+            return false;
+        }
+        if (!databases.empty()) pdb.reset(new PDBHeuristic<Variant>(&databases));
+        if (options.move_pruning) {
+            fsm.LoadOrBuild("../Search/fsm_v" + std::to_string(Variant::kNumber) + ".bin", Variant::kNumber,
+                            MovePruningFSM::DefaultDepth(Variant::kNumber));
+            move_pruning = &fsm;
+        }
+        return true;
+    }
+};
+
+// One worker's solvers for a variant, built once and reused for every
+// request. The A* solvers hold no memory between solves; there is none for
+// mod databases.
+template <typename Variant>
+struct VariantSolvers {
+    IDAstar<Variant, ManhattanHeuristic<Variant>> manhattan;
+    IDAstar<Variant, WalkingDistanceHeuristic<Variant>> walking_distance;
+    std::unique_ptr<IDAstar<Variant, PDBHeuristic<Variant>>> pdb;
+    Astar<Variant, ManhattanHeuristic<Variant>> astar_manhattan;
+    Astar<Variant, WalkingDistanceHeuristic<Variant>> astar_walking_distance;
+    std::unique_ptr<Astar<Variant, PDBHeuristic<Variant>>> astar_pdb;
+
+    VariantSolvers(const VariantTables<Variant>& tables, size_t astar_memory_mb, WorkerCounters* counters)
+        : manhattan(tables.manhattan, tables.move_pruning, nullptr, counters),
+          walking_distance(tables.walking_distance, tables.move_pruning, nullptr, counters),
+          astar_manhattan(tables.manhattan, astar_memory_mb, counters),
+          astar_walking_distance(tables.walking_distance, astar_memory_mb, counters) {
+        if (tables.pdb) {
+            pdb.reset(new IDAstar<Variant, PDBHeuristic<Variant>>(*tables.pdb, tables.move_pruning, nullptr, counters));
+            if (!tables.pdb->HasMod()) {
+                astar_pdb.reset(new Astar<Variant, PDBHeuristic<Variant>>(*tables.pdb, astar_memory_mb, counters));
+            }
+        }
+    }
+};
+
+// Runs one request and streams its iterations and result to the client. With
+// astar, A* runs first and IDA* continues from its bound past the memory cap.
+template <typename Variant, typename Heuristic>
+void RunJob(IDAstar<Variant, Heuristic>& solver, Astar<Variant, Heuristic>* astar, const Job& job, int core_num,
+            WorkerCounters& counters, ServiceCounters& service) {
+    const SolveRequest& request = job.request;
+    Connection& connection = *job.connection;
+    Puzzle puzzle(request.instance.tiles, request.variant);
+    std::ofstream no_output;
+    auto send_counts = [&](const char* kind, int bound, long long expanded, long long generated, double seconds) {
+        std::ostringstream line;
+        line << kind << ' ' << request.tag << ' ' << bound << ' ' << expanded << ' ' << generated << ' '
+             << std::fixed << std::setprecision(6) << seconds;
+        connection.Send(line.str());
+    };
+    auto send_iteration = [&](int, const IterationStats& stats, std::ofstream&) {
+        send_counts("iteration", stats.bound, stats.nodes_expanded, stats.nodes_generated, stats.wall_time);
+    };
+    counters.Begin(core_num, job.number);
+    auto result = astar ? astar->Solve(puzzle, send_iteration, core_num, no_output, job.limits)
+                        : solver.Solve(puzzle, send_iteration, core_num, no_output, job.limits);
+    SolveStatus status = astar ? astar->Status() : solver.Status();
+    int lower_bound = astar ? astar->LowerBound() : solver.LowerBound();
+    if (status == SolveStatus::MemoryLimit) {
+        const Checkpoint handoff = astar->Handoff();
+        send_counts("fallback", lower_bound, handoff.nodes_expanded, handoff.nodes_generated, handoff.elapsed);
+        result = solver.Solve(puzzle, send_iteration, core_num, no_output,
+                              job.limits.Remaining(handoff.nodes_expanded, handoff.elapsed), &handoff);
+        status = solver.Status();
+        lower_bound = solver.LowerBound();
+    }
+    counters.End();
+
+    std::ostringstream line;
+    if (status == SolveStatus::Solved) {
+        line << "solved " << request.tag << ' ' << std::get<1>(result) << ' ' << std::get<3>(result) << ' '
+             << std::get<4>(result) << ' ' << std::fixed << std::setprecision(6) << std::get<2>(result) << ' '
+             << FormatPath(std::get<0>(result));
+        service.solved++;
+    } else {
+        line << "stopped " << request.tag << ' ' << ToString(status) << ' ' << lower_bound << ' '
+             << std::get<3>(result) << ' ' << std::get<4>(result) << ' ' << std::fixed << std::setprecision(6)
+             << std::get<2>(result);
+        service.stopped++;
+    }
+    connection.Send(line.str());
+}
+
+template <typename Variant>
+void RunJob(VariantSolvers<Variant>& solvers, const Job& job, int core_num, WorkerCounters& counters,
+            ServiceCounters& service) {
+    const std::string& heuristic = job.request.heuristic;
+    const bool astar = (job.request.engine == "astar");
+    if (heuristic == "md") {
+        RunJob(solvers.manhattan, astar ? &solvers.astar_manhattan : nullptr, job, core_num, counters, service);
+    } else if (heuristic == "wd") {
+        RunJob(solvers.walking_distance, astar ? &solvers.astar_walking_distance : nullptr, job, core_num, counters,
+               service);
+    } else {
+        RunJob(*solvers.pdb, astar ? solvers.astar_pdb.get() : nullptr, job, core_num, counters, service);
+    }
+}
+
+void Work(int core_num, const VariantTables<Variant1>& tables1, const VariantTables<Variant2>& tables2,
+          size_t astar_memory_mb, JobQueue& queue, WorkerCounters& counters, ServiceCounters& service) {
+    VariantSolvers<Variant1> solvers1(tables1, astar_memory_mb, &counters);
+    VariantSolvers<Variant2> solvers2(tables2, astar_memory_mb, &counters);
+    Job job;
+    while (queue.Pop(job)) {
+        if (!job.connection->cancel.IsCancelled()) {
+            service.active++;
+            if (job.request.variant == 1) {
+                RunJob(solvers1, job, core_num, counters, service);
+            } else {
+                RunJob(solvers2, job, core_num, counters, service);
+            }
+            service.active--;
+        }
+        job = Job(); // Drops the connection
+    }
+}
+
+// Requests the loaded tables can serve, per variant
+struct Servable {
+    bool pdb[2];            // Pattern databases loaded
+    bool astar_pdb[2];      // ... and none of them mod encoded
+};
+
+// Handles one request line from a client. Returns false when the client
+// asked to close.
+bool HandleLine(const std::string& line, const std::shared_ptr<Connection>& connection, const Options& options,
+                const Servable& servable, JobQueue& queue, ServiceCounters& service) {
+    std::istringstream iss(line);
+    std::string command;
+    if (!(iss >> command)) return true;
+    if (command == "quit") {
+        connection->cancel.Cancel();
+        return false;
+    }
+    if (command == "stats") {
+        std::ostringstream reply;
+        reply << "stats received " << service.received << " solved " << service.solved << " stopped "
+              << service.stopped << " refused " << service.refused << " active " << service.active << " queued "
+              << queue.Size() << " workers " << options.num_threads;
+        connection->Send(reply.str());
+        return true;
+    }
+    if (command != "solve") {
+        connection->Send("error - unknown command " + command);
+        return true;
+    }
+
+    Job job;
+    job.number = static_cast<int>(++service.received);
+    job.request.heuristic = options.heuristic;
+    job.request.engine = options.engine;
+    std::string arguments;
+    std::getline(iss, arguments);
+    try {
+        ParseSolveRequest(arguments, job.request);
+    } catch (const std::invalid_argument& e) {
+        service.refused++;
+        connection->Send("error " + (job.request.tag.empty() ? std::string("-") : job.request.tag) + ' ' + e.what());
+        return true;
+    }
+    if (job.request.heuristic == "pdb" && !servable.pdb[job.request.variant - 1]) {
+        service.refused++;
+        connection->Send("error " + job.request.tag + " no pattern databases loaded for variant " +
+                         std::to_string(job.request.variant));
+        return true;
+    }
+    if (job.request.heuristic == "pdb" && job.request.engine == "astar" && !servable.astar_pdb[job.request.variant - 1]) {
+        service.refused++;
+        connection->Send("error " + job.request.tag + " A* cannot use mod pattern databases");
+        return true;
+    }
+
+    // A request may tighten the daemon's limits, not lift them
+    auto tighter = [](auto daemon, auto request) {
+        return (daemon <= 0 || (request > 0 && request < daemon)) ? request : daemon;
+    };
+    job.limits.max_nodes = tighter(options.max_nodes, job.request.max_nodes);
+    job.limits.max_seconds = tighter(options.max_time, job.request.max_time);
+    job.limits.cancel = &connection->cancel;
+    job.connection = connection;
+
+    // A worker may pop the job and send its first lines at once; pushing
+    // under the send lock keeps the queued line ahead of them
+    const std::string tag = job.request.tag;
+    bool full = false;
+    connection->SendWith([&] {
+        const size_t position = queue.Push(std::move(job));
+        full = (position == 0);
+        return full ? "error " + tag + " queue full" : "queued " + tag + ' ' + std::to_string(position);
+    });
+    if (full) service.refused++;
+    return true;
+}
+
+// Listening socket at path. A leftover socket file nobody accepts on is
+// replaced; a live one means another daemon is running.
+int Listen(const std::string& path) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+    struct stat info;
+    if (lstat(path.c_str(), &info) == 0) {
+        if (!S_ISSOCK(info.st_mode)) {
+            std::cerr << path << " exists and is no socket\n";
+            return -1;
+        }
+        const int probe = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        const bool live = connect(probe, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0;
+        close(probe);
+        if (live) {
+            std::cerr << "Another daemon is listening on " << path << "\n";
+            return -1;
+        }
+        unlink(path.c_str());
+    }
+
+    const int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0 || bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(fd, 64) != 0) {
+        std::cerr << "Failed to listen on " << path << ": " << std::strerror(errno) << "\n";
+        if (fd >= 0) close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Accepts clients, reads their requests and flushes their output until a
+// stop signal, never blocking on a client. poll() wakes every 200 ms to
+// notice the signal and output that workers could not write.
+void Serve(int listen_fd, const Options& options, const Servable& servable, JobQueue& queue,
+           ServiceCounters& service) {
+    static const size_t kMaxLine = 1 << 16;
+    std::vector<std::shared_ptr<Connection>> clients; // Reading, or with output or solves pending
+    std::vector<pollfd> fds;
+    char buffer[4096];
+
+    while (!stop_token.IsCancelled()) {
+        fds.assign(1, pollfd{listen_fd, POLLIN, 0});
+        for (const auto& client : clients) {
+            // A client that neither reads nor has output is left out: a hung up
+            // socket would wake poll() at once, every time
+            const short events = (client->reading ? POLLIN : 0) | (client->HasOutput() ? POLLOUT : 0);
+            fds.push_back(pollfd{events ? client->Fd() : -1, events, 0});
+        }
+        if (poll(fds.data(), fds.size(), 200) < 0) {
+            if (errno == EINTR) continue;
+            std::cerr << "poll failed: " << std::strerror(errno) << "\n";
+            break;
+        }
+
+        std::vector<std::shared_ptr<Connection>> still_open;
+        for (size_t c = 0; c < clients.size(); ++c) {
+            const auto& client = clients[c];
+            const short revents = fds[c + 1].revents;
+            if (client->reading && (revents & (POLLIN | POLLHUP | POLLERR))) {
+                const ssize_t n = recv(client->Fd(), buffer, sizeof(buffer), 0);
+                if (n >= 0 || (errno != EINTR && errno != EAGAIN && errno != EWOULDBLOCK)) {
+                    bool reading = n > 0;
+                    if (reading) client->input.append(buffer, static_cast<size_t>(n));
+                    size_t start = 0;
+                    for (size_t end; reading && (end = client->input.find('\n', start)) != std::string::npos;
+                         start = end + 1) {
+                        reading = HandleLine(client->input.substr(start, end - start), client, options, servable,
+                                             queue, service);
+                    }
+                    client->input.erase(0, start);
+                    if (reading && client->input.size() > kMaxLine) {
+                        client->Send("error - line too long");
+                        client->cancel.Cancel();
+                        reading = false;
+                    }
+                    if (client->cancel.IsCancelled()) reading = false; // Gone, or asked to quit
+                    // A client done writing keeps getting the lines of its solves
+                    if (!reading) {
+                        client->reading = false;
+                        shutdown(client->Fd(), SHUT_RD);
+                    }
+                }
+            }
+            client->Flush();
+
+            // Kept while it may still get lines: reading, output pending, or
+            // held by a queued or running job
+            if (client->reading || client->HasOutput() || client.use_count() > 1) still_open.push_back(client);
+        }
+        clients.swap(still_open);
+
+        if (fds[0].revents & POLLIN) {
+            const int fd = accept4(listen_fd, nullptr, nullptr, SOCK_CLOEXEC | SOCK_NONBLOCK);
+            if (fd >= 0) clients.push_back(std::make_shared<Connection>(fd));
+        }
+    }
+
+    for (const auto& client : clients) client->cancel.Cancel();
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    try {
+        ParseOptions(argc, argv, options);
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << "\n";
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    // Everything a request needs is loaded before the socket opens
+    WalkingDistance walking_distance;
+    walking_distance.LoadOrBuild(options.wd_file);
+    VariantTables<Variant1> tables1(&walking_distance);
+    VariantTables<Variant2> tables2(&walking_distance);
+    if (!tables1.Load(options) || !tables2.Load(options)) return 1;
+    const Servable servable = {{tables1.pdb != nullptr, tables2.pdb != nullptr},
+                               {tables1.pdb && !tables1.pdb->HasMod(), tables2.pdb && !tables2.pdb->HasMod()}};
+
+    const int listen_fd = Listen(options.socket_path);
+    if (listen_fd < 0) return 1;
+    std::signal(SIGINT, HandleStopSignal);
+    std::signal(SIGTERM, HandleStopSignal);
+
+    Telemetry telemetry(options.num_threads);
+    if (options.report_interval > 0) telemetry.Start(options.report_interval, std::cout, nullptr);
+    JobQueue queue(options.max_queued);
+    ServiceCounters service;
+    std::vector<std::thread> workers;
+    for (int i = 0; i < options.num_threads; ++i) {
+        workers.emplace_back(Work, i, std::cref(tables1), std::cref(tables2), options.astar_memory_mb, std::ref(queue),
+                             std::ref(telemetry.Worker(i)), std::ref(service));
+    }
+    std::cout << "Listening on " << options.socket_path << " with " << options.num_threads << " workers" << std::endl;
+
+    Serve(listen_fd, options, servable, queue, service);
+
+    close(listen_fd);
+    unlink(options.socket_path.c_str());
+    queue.Close();
+    for (auto& worker : workers) worker.join();
+    telemetry.Stop();
+    std::cout << "Stopped (" << service.received << " requests, " << service.solved << " solved, " << service.stopped
+              << " stopped early, " << service.refused << " refused)" << std::endl;
+    return 0;
+}
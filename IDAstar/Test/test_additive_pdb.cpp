@@ -0,0 +1,91 @@
+#include "../IDAstar.h"
+#include "../../PDB/GeneratePDB.h"
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <random>
+#include <unordered_map>
+
+// Additive PDBs {1,2,3,4} + {5,6,7,8} on the 8-puzzle, checked against a
+// breadth-first search of the whole state space for both variants
+namespace Test {
+    const char* const kFiles[2] = {"test_additive_a.bin", "test_additive_b.bin"};
+    const std::vector<int> kPatterns[2] = {{1, 2, 3, 4}, {5, 6, 7, 8}};
+
+    uint64_t Pack(const std::array<int, 9>& tiles) {
+        uint64_t key = 0;
+        for (int tile : tiles) key = key << 4 | tile;
+        return key;
+    }
+
+    // Optimal solution length of every state, by BFS from the goal
+    template <typename Variant>
+    std::unordered_map<uint64_t, int> Distances() {
+        typename Variant::Board goal{{0, 1, 2, 3, 4, 5, 6, 7, 8}, 0};
+        std::unordered_map<uint64_t, int> distance = {{Pack(goal.tiles), 0}};
+        std::vector<typename Variant::Board> frontier = {goal}, next;
+        for (int depth = 1; !frontier.empty(); ++depth) {
+            next.clear();
+            for (auto board : frontier) {
+                const auto& moves = Variant::Moves(board.blank);
+                for (int m = 0; m < moves.size; ++m) {
+                    board.Apply(moves.moves[m]);
+                    if (distance.emplace(Pack(board.tiles), depth).second) next.push_back(board);
+                    board.Undo(moves.moves[m]);
+                }
+            }
+            frontier.swap(next);
+        }
+        return distance;
+    }
+
+    template <typename Variant>
+    void testAdmissible(int variant) {
+        std::vector<PatternDatabase> databases(2);
+        for (int d = 0; d < 2; ++d) {
+            std::unordered_set<int> pattern(kPatterns[d].begin(), kPatterns[d].end());
+            pattern.insert(0);
+            BasicGeneratePDB<3, 3> generator(pattern, variant, kFiles[d]);
+            generator.BuildPDB();
+            generator.SaveToFile();
+            bool loaded = databases[d].Load(kFiles[d], kPatterns[d], variant, 3, 3);
+            assert(loaded);
+            std::remove(kFiles[d]);
+        }
+        PDBHeuristic<Variant> heuristic(&databases);
+
+        // The sum never exceeds the optimal length
+        const auto distance = Distances<Variant>();
+        assert(distance.size() == 181440);
+        std::vector<typename Variant::Puzzle::Tiles> states;
+        for (const auto& [key, length] : distance) {
+            typename Variant::Board board{};
+            for (int p = 8; p >= 0; --p) {
+                board.tiles[p] = static_cast<int>(key >> (4 * (8 - p)) & 15);
+                if (board.tiles[p] == 0) board.blank = p;
+            }
+            assert(heuristic.Value(heuristic.Root(board)) <= length);
+            if (states.size() < 200) states.push_back(board.tiles);
+        }
+
+        // IDA* with the sum finds optimal solutions
+        IDAstar<Variant, PDBHeuristic<Variant>> solver(heuristic);
+        std::ofstream no_output;
+        for (const auto& tiles : states) {
+            typename Variant::Puzzle puzzle(tiles, variant);
+            auto result = solver.Solve(puzzle, [](int, const IterationStats&, std::ofstream&) {}, 0, no_output);
+            std::array<int, 9> key;
+            std::copy(tiles.begin(), tiles.end(), key.begin());
+            assert(std::get<1>(result) == distance.at(Pack(key)));
+        }
+        std::cout << "Variant " << variant << " additive PDB test passed\n";
+    }
+}
+
+int main() {
+    Test::testAdmissible<Variant<1, 3, 3>>(1);
+    Test::testAdmissible<Variant<2, 3, 3>>(2);
+    return 0;
+}
+
+// g++ -std=c++17 -O2 test_additive_pdb.cpp ../IDAstar.cpp ../Heuristic.cpp ../../PDB/GeneratePDB.cpp ../../PDB/AbstractPuzzlePDB.cpp ../../Puzzle/Puzzle.cpp ../../Heuristics/WalkingDistance.cpp ../../Search/MovePruningFSM.cpp ../../Search/TranspositionTable.cpp ../../Search/HugePages.cpp ../../Search/Ranking.cpp -o test_additive_pdb
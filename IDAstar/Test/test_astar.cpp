@@ -0,0 +1,95 @@
+#include "../Astar.h"
+#include "../IDAstar.h"
+#include <algorithm>
+#include <iostream>
+#include <cassert>
+#include <random>
+
+namespace Test {
+    // Korf #1 and #2
+    const std::vector<Puzzle::Tiles> kKorf = {
+        {14, 13, 15, 7, 11, 12, 9, 5, 6, 0, 2, 1, 4, 8, 10, 3},
+        {13, 5, 4, 10, 9, 12, 8, 14, 2, 3, 7, 1, 0, 15, 11, 6},
+    };
+
+    const auto kNoCallback = [](int, const IterationStats&, std::ofstream&) {};
+
+    // Random walk of the given length from the goal
+    Puzzle::Tiles Scramble(int variant, int moves, std::mt19937& rng) {
+        Puzzle puzzle({0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15}, variant);
+        for (int i = 0; i < moves; ++i) {
+            const auto actions = puzzle.GetPossibleActions();
+            puzzle.ApplyAction(actions[rng() % actions.size()]);
+        }
+        return puzzle.GetTiles();
+    }
+
+    template <typename Variant>
+    void testOptimalLengths(int variant) {
+        ManhattanHeuristic<Variant> heuristic;
+        Astar<Variant, ManhattanHeuristic<Variant>> astar(heuristic);
+        IDAstar<Variant, ManhattanHeuristic<Variant>> idastar(heuristic);
+        std::ofstream no_output;
+        std::mt19937 rng(11);
+        for (int i = 0; i < 30; ++i) {
+            const Puzzle::Tiles tiles = Scramble(variant, 60, rng);
+            Puzzle start(tiles, variant), reference(tiles, variant);
+            auto result = astar.Solve(start, kNoCallback, 0, no_output);
+            auto expected = idastar.Solve(reference, kNoCallback, 0, no_output);
+            assert(astar.Status() == SolveStatus::Solved);
+            assert(std::get<1>(result) == std::get<1>(expected) && astar.LowerBound() == std::get<1>(result));
+
+            // The path leads from the start to the goal
+            Puzzle replay(tiles, variant);
+            for (const auto& action : std::get<0>(result)) replay.ApplyAction(action);
+            assert(replay.GoalTest() && std::get<5>(result).GoalTest());
+        }
+        std::cout << "Variant " << variant << " optimal length test passed\n";
+    }
+
+    void testMemoryLimit() {
+        ManhattanHeuristic<Variant1> heuristic;
+        Astar<Variant1, ManhattanHeuristic<Variant1>> astar(heuristic, 1);
+        IDAstar<Variant1, ManhattanHeuristic<Variant1>> idastar(heuristic);
+        std::ofstream no_output;
+        for (const auto& tiles : kKorf) {
+            Puzzle puzzle(tiles, 1);
+            auto stopped = astar.Solve(puzzle, kNoCallback, 0, no_output);
+            assert(astar.Status() == SolveStatus::MemoryLimit && std::get<0>(stopped).empty());
+
+            // IDA* continues from the bound A* proved
+            const Checkpoint handoff = astar.Handoff();
+            assert(std::equal(tiles.begin(), tiles.end(), handoff.tiles.begin()) && handoff.nodes_expanded == std::get<3>(stopped));
+            auto resumed = idastar.Solve(puzzle, kNoCallback, 0, no_output, SearchLimits(), &handoff);
+            Puzzle fresh(tiles, 1);
+            auto expected = idastar.Solve(fresh, kNoCallback, 0, no_output);
+            assert(astar.LowerBound() <= std::get<1>(expected));
+            assert(std::get<1>(resumed) == std::get<1>(expected));
+            assert(std::get<3>(resumed) > handoff.nodes_expanded);
+        }
+        std::cout << "Memory limit test passed\n";
+    }
+
+    void testNodeLimit() {
+        ManhattanHeuristic<Variant2> heuristic;
+        Astar<Variant2, ManhattanHeuristic<Variant2>> astar(heuristic);
+        std::ofstream no_output;
+        Puzzle puzzle(kKorf[0], 2);
+        SearchLimits limits;
+        limits.max_nodes = 1000;
+        auto result = astar.Solve(puzzle, kNoCallback, 0, no_output, limits);
+        assert(astar.Status() == SolveStatus::NodeLimit && std::get<1>(result) == -1);
+        assert(std::get<3>(result) == 1000);
+        std::cout << "Node limit test passed\n";
+    }
+}
+
+int main() {
+    Test::testOptimalLengths<Variant1>(1);
+    Test::testOptimalLengths<Variant2>(2);
+    Test::testMemoryLimit();
+    Test::testNodeLimit();
+    return 0;
+}
+
+// g++ -std=c++17 -O2 test_astar.cpp ../Astar.cpp ../IDAstar.cpp ../Heuristic.cpp ../../Puzzle/Puzzle.cpp ../../Heuristics/WalkingDistance.cpp ../../Search/MovePruningFSM.cpp ../../Search/TranspositionTable.cpp ../../Search/HugePages.cpp ../../Search/Ranking.cpp -o test_astar
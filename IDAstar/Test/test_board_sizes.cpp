@@ -0,0 +1,109 @@
+#include "../IDAstar.h"
+#include <iostream>
+#include <cassert>
+#include <random>
+
+namespace Test {
+    template <typename Variant>
+    int SolveLength(const typename Variant::Puzzle::Tiles& tiles) {
+        ManhattanHeuristic<Variant> heuristic;
+        IDAstar<Variant, ManhattanHeuristic<Variant>> solver(heuristic);
+        typename Variant::Puzzle puzzle(tiles, Variant::kNumber);
+        std::ofstream no_output;
+        auto result = solver.Solve(puzzle, [](int, const IterationStats&, std::ofstream&) {}, 0, no_output);
+        assert(std::get<5>(result).GoalTest());
+        return std::get<1>(result);
+    }
+
+    void testMoveTables() {
+        // Corner, edge and centre of the 5x5 board
+        assert((Variant<1, 5, 5>::Moves(0).size == 2 && Variant<1, 5, 5>::Moves(12).size == 4));
+        assert((Variant<2, 5, 5>::Moves(0).size == 5 && Variant<2, 5, 5>::Moves(12).size == 6));
+        assert((Variant<2, 3, 3>::Moves(4).size == 4 && Variant<2, 5, 5>::kMaxSlide == 4));
+        assert((Variant<1, 5, 5>::Moves(12).moves[2].step == -5));
+        assert((Variant2::Moves(0).size == 4 && Variant2::kMaxChildren == 5));
+        std::cout << "Move table test passed\n";
+    }
+
+    void testSolvability() {
+        assert((BasicPuzzle<3, 3>::IsSolvable({1, 0, 2, 3, 4, 5, 6, 7, 8})));
+        assert((!BasicPuzzle<3, 3>::IsSolvable({0, 2, 1, 3, 4, 5, 6, 7, 8})));
+        assert((!BasicPuzzle<3, 3>::IsSolvable({0, 1, 2, 3, 4, 5, 6, 7, 7})));
+        std::cout << "Solvability test passed\n";
+    }
+
+    void testOptimalLengths() {
+        // Optimal lengths from a breadth-first search of the whole 8-puzzle
+        assert((SolveLength<Variant<1, 3, 3>>({4, 1, 6, 7, 8, 0, 5, 2, 3}) == 23));
+        assert((SolveLength<Variant<2, 3, 3>>({4, 1, 6, 7, 8, 0, 5, 2, 3}) == 20));
+        assert((SolveLength<Variant<1, 3, 3>>({8, 3, 5, 7, 6, 4, 2, 0, 1}) == 25));
+        assert((SolveLength<Variant<2, 3, 3>>({8, 3, 5, 7, 6, 4, 2, 0, 1}) == 23));
+
+        // A 60-move random walk on the 24-puzzle
+        assert((SolveLength<Variant<1, 5, 5>>({5, 6, 1, 3, 4, 10, 2, 8, 13, 7, 21, 11, 18, 12, 9, 15, 17, 22, 19, 14,
+                                               16, 20, 0, 23, 24}) == 40));
+        std::cout << "Optimal length test passed\n";
+    }
+
+    // Min tables over 5x5 patterns whose ranks pass 2^32: one entry per 2^28
+    // ranks, so a truncated rank reads the wrong entry
+    PatternDatabase LargePattern(const std::vector<int>& pattern) {
+        PatternDatabase database;
+        database.SetPattern(pattern, 5, 5);
+        database.encoding = PDBFormat::Encoding::Min;
+        database.group_size = 1ULL << 28;
+        database.table.resize((database.NumStates() >> 28) + 1);
+        for (size_t i = 0; i < database.table.size(); ++i) database.table[i] = static_cast<uint8_t>(i % 200);
+        return database;
+    }
+
+    // Children evaluated together agree with each child evaluated from scratch
+    void testLargeRanks(const std::vector<PatternDatabase>& databases) {
+        using Variant = ::Variant<1, 5, 5>;
+        PDBHeuristic<Variant> heuristic(&databases);
+        Variant::Board board{};
+        for (int p = 0; p < 25; ++p) board.tiles[p] = p;
+        std::mt19937 rng(5);
+        PDBHeuristic<Variant>::State state = heuristic.Root(board);
+        for (int step = 0; step < 2000; ++step) {
+            const MoveList& moves = Variant::Moves(board.blank);
+            const Move* batch[Variant::kMaxChildren];
+            PDBHeuristic<Variant>::State children[Variant::kMaxChildren];
+            for (int m = 0; m < moves.size; ++m) batch[m] = &moves.moves[m];
+            heuristic.PrepareChildren(state, board, batch, moves.size, children);
+            for (int m = 0; m < moves.size; ++m) {
+                heuristic.FinishChild(children[m]);
+                board.Apply(moves.moves[m]);
+                assert(heuristic.Value(children[m]) == heuristic.Value(heuristic.Root(board)));
+                board.Undo(moves.moves[m]);
+            }
+            const int next = rng() % moves.size;
+            board.Apply(moves.moves[next]);
+            state = children[next];
+        }
+    }
+
+    void testLargePatterns() {
+        // 8 tiles: 25!/17! ranks, multipliers within the 32-bit ranking lanes
+        std::vector<PatternDatabase> databases;
+        databases.push_back(LargePattern({1, 2, 3, 4, 5, 6, 7, 8}));
+        assert(databases[0].NumStates() > (1ULL << 32) && databases[0].multipliers[0] <= UINT32_MAX);
+        testLargeRanks(databases);
+
+        // 9 tiles: multipliers past 32 bits, ranked one database at a time
+        databases.push_back(LargePattern({9, 10, 11, 12, 13, 14, 15, 16, 17}));
+        assert(databases[1].multipliers[0] > UINT32_MAX);
+        testLargeRanks(databases);
+        std::cout << "Large pattern rank test passed\n";
+    }
+}
+
+int main() {
+    Test::testMoveTables();
+    Test::testSolvability();
+    Test::testOptimalLengths();
+    Test::testLargePatterns();
+    return 0;
+}
+
+// g++ -std=c++17 -O2 test_board_sizes.cpp ../IDAstar.cpp ../Heuristic.cpp ../../Puzzle/Puzzle.cpp ../../Heuristics/WalkingDistance.cpp ../../Search/MovePruningFSM.cpp ../../Search/TranspositionTable.cpp ../../Search/HugePages.cpp ../../Search/Ranking.cpp -o test_board_sizes
@@ -0,0 +1,65 @@
+#include "../Checkpoint.h"
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+
+namespace Test {
+    void testRoundTrip() {
+        Checkpoint saved;
+        saved.puzzle_num = 17;
+        saved.tiles = {14, 13, 15, 7, 11, 12, 9, 5, 6, 0, 2, 1, 4, 8, 10, 3};
+        saved.solver = "v2_pdb+fsm";
+        saved.bound = 41;
+        saved.frontier_min = 43;
+        saved.path = {{Left, 1}, {Up, 1}, {Right, 3}, {Down, 1}};
+        saved.iterations = 6;
+        saved.nodes_expanded = 123456789012LL;
+        saved.nodes_generated = 223456789012LL;
+        saved.elapsed = 3601.25;
+
+        const std::string filepath = "test_checkpoint.txt";
+        assert(saved.Save(filepath));
+        Checkpoint loaded;
+        assert(loaded.Load(filepath));
+        assert(loaded.puzzle_num == 17 && loaded.tiles == saved.tiles && loaded.solver == saved.solver);
+        assert(!loaded.solved && loaded.bound == 41 && loaded.frontier_min == 43);
+        assert(loaded.path.size() == 4 && loaded.path[2].dir == Right && loaded.path[2].steps == 3);
+        assert(loaded.iterations == 6 && loaded.nodes_expanded == saved.nodes_expanded);
+        assert(loaded.nodes_generated == saved.nodes_generated && loaded.elapsed == saved.elapsed);
+        assert(loaded.HasPosition());
+
+        // Iteration boundary: no position
+        saved.path.clear();
+        saved.frontier_min = Checkpoint::kNoFrontier;
+        assert(saved.Save(filepath));
+        assert(loaded.Load(filepath));
+        assert(loaded.path.empty() && loaded.frontier_min == Checkpoint::kNoFrontier && !loaded.HasPosition());
+        std::remove(filepath.c_str());
+        std::cout << "Round trip test passed\n";
+    }
+
+    void testRejects() {
+        Checkpoint loaded;
+        assert(!loaded.Load("missing_checkpoint.txt"));
+
+        const std::string filepath = "test_checkpoint.txt";
+        {
+            std::ofstream out(filepath);
+            out << "puzzle 3\nbound x\n"; // Truncated and malformed
+        }
+        loaded.bound = 7;
+        assert(!loaded.Load(filepath));
+        assert(loaded.bound == 7); // Left untouched
+        std::remove(filepath.c_str());
+        std::cout << "Reject test passed\n";
+    }
+}
+
+int main() {
+    Test::testRoundTrip();
+    Test::testRejects();
+    return 0;
+}
+
+// g++ -std=c++17 -O2 test_checkpoint.cpp ../Checkpoint.cpp -o test_checkpoint
@@ -0,0 +1,99 @@
+#include "../IDAstar.h"
+#include "../../PDB/GeneratePDB.h"
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+namespace Test {
+    using Variant = ::Variant<1, 3, 3>;
+    using Puzzle = Variant::Puzzle;
+
+    const std::vector<int> kPattern = {1, 2, 3, 4, 5};
+    const char* const kRawFile = "test_delta_raw.bin";
+    const char* const kDeltaFile = "test_delta_delta.bin";
+
+    void Generate(const char* filepath, PDBFormat::Encoding encoding) {
+        BasicGeneratePDB<3, 3> generator({0, 1, 2, 3, 4, 5}, 1, filepath, encoding);
+        generator.BuildPDB();
+        generator.SaveToFile();
+    }
+
+    std::array<uint8_t, 9> Positions(const Puzzle::Tiles& tiles) {
+        std::array<uint8_t, 9> positions{};
+        for (int p = 0; p < 9; ++p) positions[tiles[p]] = p;
+        return positions;
+    }
+
+    void testSelect() {
+        for (uint64_t x : {0x1ULL, 0x8000000000000000ULL, 0xF0F0F0F0F0F0F0F0ULL, 0x123456789ABCDEFULL}) {
+            uint32_t index = 0;
+            for (int bit = 0; bit < 64; ++bit) {
+                if (x & (1ULL << bit)) assert(PDBFormat::Select64(x, index++) == bit);
+            }
+        }
+        // Codes 3, 0, 70 (crossing a word), 1
+        uint8_t block[PDBFormat::kDeltaBlockBytes] = {};
+        uint64_t words[PDBFormat::kDeltaBlockBytes / 8] = {0x7ULL | ~0ULL << 5, 0x17FFULL};
+        std::memcpy(block, words, sizeof(words));
+        assert(PDBFormat::DeltaSymbol(block, 0) == 3);
+        assert(PDBFormat::DeltaSymbol(block, 1) == 0);
+        assert(PDBFormat::DeltaSymbol(block, 2) == 70);
+        assert(PDBFormat::DeltaSymbol(block, 3) == 1);
+        assert(PDBFormat::DeltaSymbol(block, 4) == 0);
+        std::cout << "Delta select test passed\n";
+    }
+
+    void testDecoding(const PatternDatabase& raw, const PatternDatabase& delta) {
+        assert(delta.Delta() && delta.VariantOneOnly() && !raw.Delta());
+        assert(delta.table.size() < raw.table.size() / 2);
+
+        // Every state a random walk reaches decodes to the raw entry
+        std::mt19937 rng(7);
+        Puzzle::Tiles tiles = {0, 1, 2, 3, 4, 5, 6, 7, 8};
+        int blank = 0;
+        for (int step = 0; step < 20000; ++step) {
+            const auto& moves = Variant::Moves(blank);
+            const Move& move = moves.moves[rng() % moves.size];
+            std::swap(tiles[blank], tiles[blank + move.step]);
+            blank += move.step;
+            const auto positions = Positions(tiles);
+            const uint64_t rank = delta.Rank(positions);
+            assert(delta.RootValue(positions) == raw.table[rank]);
+            assert(delta.ChildValue(0, rank, positions) == raw.table[rank]);
+        }
+        std::cout << "Delta decoding test passed\n";
+    }
+
+    void testOptimalLengths(const std::vector<PatternDatabase>* databases) {
+        PDBHeuristic<Variant> heuristic(databases);
+        IDAstar<Variant, PDBHeuristic<Variant>> solver(heuristic);
+        std::ofstream no_output;
+        Puzzle puzzle({8, 3, 5, 7, 6, 4, 2, 0, 1}, 1);
+        auto result = solver.Solve(puzzle, [](int, const IterationStats&, std::ofstream&) {}, 0, no_output);
+        assert(std::get<1>(result) == 25);
+        std::cout << "Delta optimal length test passed\n";
+    }
+}
+
+int main() {
+    Test::testSelect();
+
+    Test::Generate(Test::kRawFile, PDBFormat::Encoding::Raw);
+    Test::Generate(Test::kDeltaFile, PDBFormat::Encoding::Delta);
+    std::vector<PatternDatabase> databases(2);
+    bool loaded = databases[0].Load(Test::kRawFile, Test::kPattern, 1, 3, 3);
+    loaded = databases[1].Load(Test::kDeltaFile, Test::kPattern, 1, 3, 3) && loaded;
+    assert(loaded);
+
+    Test::testDecoding(databases[0], databases[1]);
+    databases.erase(databases.begin());
+    Test::testOptimalLengths(&databases);
+
+    std::remove(Test::kRawFile);
+    std::remove(Test::kDeltaFile);
+    return 0;
+}
+
+// g++ -std=c++17 -O2 test_delta_pdb.cpp ../IDAstar.cpp ../Heuristic.cpp ../../PDB/GeneratePDB.cpp ../../PDB/AbstractPuzzlePDB.cpp ../../Puzzle/Puzzle.cpp ../../Heuristics/WalkingDistance.cpp ../../Search/MovePruningFSM.cpp ../../Search/TranspositionTable.cpp ../../Search/HugePages.cpp ../../Search/Ranking.cpp -o test_delta_pdb
@@ -0,0 +1,75 @@
+#include "../InstanceStream.h"
+#include "../../Puzzle/Puzzle.h"
+#include <iostream>
+#include <cassert>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace Test {
+    bool Rejects(const std::string& line) {
+        Instance instance;
+        try {
+            ParseInstance(line, 1, instance);
+        } catch (const std::invalid_argument&) {
+            return true;
+        }
+        return false;
+    }
+
+    void testParse() {
+        Instance instance;
+        // korf100 format keeps its id
+        assert(ParseInstance(" 1   14 13 15 7 11 12 9 5 6 0 2 1 4 8 10 3", 7, instance));
+        assert(instance.id == 1 && instance.tiles[0] == 14 && instance.tiles[15] == 3);
+        // Bare tiles take the running id
+        assert(ParseInstance("0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15", 7, instance));
+        assert(instance.id == 7 && instance.tiles[0] == 0);
+        assert(!ParseInstance("", 1, instance));
+        assert(!ParseInstance("   \r", 1, instance));
+        assert(!ParseInstance("# comment", 1, instance));
+
+        assert(Rejects("0 1 2 3"));
+        assert(Rejects("0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 x"));
+        assert(Rejects("0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 16"));
+        assert(Rejects("0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 14"));
+        // Two swapped tiles change the permutation parity only
+        assert(Rejects("0 1 2 3 4 5 6 7 8 9 10 11 12 13 15 14"));
+        // Moving the blank one cell changes both parities
+        assert(!Rejects("1 0 2 3 4 5 6 7 8 9 10 11 12 13 14 15"));
+        std::cout << "Parse test passed\n";
+    }
+
+    void testQueue() {
+        std::istringstream input(
+            "# three instances\n"
+            "0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15\n"
+            "not an instance\n"
+            "1 0 2 3 4 5 6 7 8 9 10 11 12 13 14 15\n"
+            "42 4 1 2 3 0 5 6 7 8 9 10 11 12 13 14 15\n");
+        // Capacity 1 forces the reader to wait for the consumer
+        InstanceQueue queue(1);
+        std::vector<int> ids;
+        std::thread consumer([&] {
+            Instance instance;
+            while (queue.Pop(instance)) ids.push_back(instance.id);
+        });
+        int next_id = 1;
+        long long count = ReadInstances(input, "test", next_id, queue);
+        queue.Close();
+        consumer.join();
+        assert(count == 3);
+        assert((ids == std::vector<int>{1, 2, 42}));
+        assert(next_id == 4);
+        std::cout << "Queue test passed\n";
+    }
+}
+
+int main() {
+    Test::testParse();
+    Test::testQueue();
+    return 0;
+}
+
+// g++ -std=c++17 -O2 -pthread test_instance_stream.cpp ../InstanceStream.cpp ../../Puzzle/Puzzle.cpp -o test_instance_stream
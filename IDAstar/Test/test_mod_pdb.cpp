@@ -0,0 +1,107 @@
+#include "../IDAstar.h"
+#include "../../PDB/GeneratePDB.h"
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <random>
+
+namespace Test {
+    using Variant = ::Variant<1, 3, 3>;
+    using Puzzle = Variant::Puzzle;
+
+    const std::vector<int> kPattern = {1, 2, 3, 4};
+    const char* const kRawFile = "test_mod_raw.bin";
+    const char* const kHeaderlessFile = "test_mod_headerless.bin";
+    const char* const kModFile = "test_mod_mod.bin";
+
+    void Generate(const char* filepath, PDBFormat::Encoding encoding) {
+        BasicGeneratePDB<3, 3> generator({0, 1, 2, 3, 4}, 1, filepath, encoding);
+        generator.BuildPDB();
+        generator.SaveToFile();
+    }
+
+    std::array<uint8_t, 9> Positions(const Puzzle::Tiles& tiles) {
+        std::array<uint8_t, 9> positions{};
+        for (int p = 0; p < 9; ++p) positions[tiles[p]] = p;
+        return positions;
+    }
+
+    void testDecoding(const PatternDatabase& raw, const PatternDatabase& mod) {
+        assert(mod.Mod() && !raw.Mod());
+        assert(mod.modulus % 2 == 1 && mod.table.size() < raw.table.size());
+
+        // Children decoded from their parent's value agree with decoding from
+        // scratch and with the raw table: the entries are exact
+        std::mt19937 rng(7);
+        Puzzle::Tiles tiles = {0, 1, 2, 3, 4, 5, 6, 7, 8};
+        int blank = 0;
+        uint8_t value = mod.RootValue(Positions(tiles));
+        assert(value == 0);
+        for (int step = 0; step < 20000; ++step) {
+            const auto& moves = Variant::Moves(blank);
+            const Move& move = moves.moves[rng() % moves.size];
+            std::swap(tiles[blank], tiles[blank + move.step]);
+            blank += move.step;
+            const auto positions = Positions(tiles);
+            const uint8_t child = mod.ChildValue(value, mod.Rank(positions), positions);
+            assert(child == mod.RootValue(positions));
+            assert(child == raw.table[raw.Rank(positions)]);
+            value = child;
+        }
+        std::cout << "Mod decoding test passed (h mod " << mod.modulus << ")\n";
+    }
+
+    void testOptimalLengths(const std::vector<PatternDatabase>* databases) {
+        PDBHeuristic<Variant> heuristic(databases);
+        IDAstar<Variant, PDBHeuristic<Variant>> solver(heuristic);
+        std::ofstream no_output;
+        Puzzle puzzle({8, 3, 5, 7, 6, 4, 2, 0, 1}, 1);
+        auto result = solver.Solve(puzzle, [](int, const IterationStats&, std::ofstream&) {}, 0, no_output);
+        assert(std::get<1>(result) == 25);
+        std::cout << "Mod optimal length test passed\n";
+    }
+}
+
+int main() {
+    Test::Generate(Test::kRawFile, PDBFormat::Encoding::Raw);
+    Test::Generate(Test::kModFile, PDBFormat::Encoding::Mod);
+    std::vector<PatternDatabase> databases(2);
+    bool loaded = databases[0].Load(Test::kRawFile, Test::kPattern, 1, 3, 3);
+    loaded = databases[1].Load(Test::kModFile, Test::kPattern, 1, 3, 3) && loaded;
+    assert(loaded);
+
+    // The header's variant must match the solver's
+    PatternDatabase other_variant;
+    assert(!other_variant.Load(Test::kModFile, Test::kPattern, 2, 3, 3));
+    assert(!other_variant.Load(Test::kRawFile, Test::kPattern, 2, 3, 3));
+
+    // A raw table without a header (the original format) is refused
+    {
+        std::ifstream in(Test::kRawFile, std::ios::binary);
+        in.seekg(sizeof(PDBFormat::Header));
+        std::ofstream out(Test::kHeaderlessFile, std::ios::binary);
+        out << in.rdbuf();
+    }
+    PatternDatabase headerless;
+    assert(!headerless.Load(Test::kHeaderlessFile, Test::kPattern, 1, 3, 3));
+    std::remove(Test::kHeaderlessFile);
+
+    // A version-1 header is rejected, not read as a raw table
+    {
+        std::fstream file(Test::kModFile, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(PDBFormat::kVersionByte);
+        file.put('\1');
+    }
+    PatternDatabase old_version;
+    assert(!old_version.Load(Test::kModFile, Test::kPattern, 1, 3, 3));
+
+    Test::testDecoding(databases[0], databases[1]);
+    databases.erase(databases.begin());
+    Test::testOptimalLengths(&databases);
+
+    std::remove(Test::kRawFile);
+    std::remove(Test::kModFile);
+    return 0;
+}
+
+// g++ -std=c++17 -O2 test_mod_pdb.cpp ../IDAstar.cpp ../Heuristic.cpp ../../PDB/GeneratePDB.cpp ../../PDB/AbstractPuzzlePDB.cpp ../../Puzzle/Puzzle.cpp ../../Heuristics/WalkingDistance.cpp ../../Search/MovePruningFSM.cpp ../../Search/TranspositionTable.cpp ../../Search/HugePages.cpp ../../Search/Ranking.cpp -o test_mod_pdb
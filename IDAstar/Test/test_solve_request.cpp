@@ -0,0 +1,61 @@
+#include "../SolveRequest.h"
+#include <iostream>
+#include <cassert>
+#include <stdexcept>
+
+namespace Test {
+    const std::string kTiles = " 14 13 15 7 11 12 9 5 6 0 2 1 4 8 10 3";
+
+    bool Rejects(const std::string& arguments) {
+        SolveRequest request;
+        try {
+            ParseSolveRequest(arguments, request);
+        } catch (const std::invalid_argument&) {
+            return true;
+        }
+        return false;
+    }
+
+    void testParse() {
+        // Defaults survive a request without options
+        SolveRequest request;
+        request.heuristic = "pdb";
+        ParseSolveRequest("first" + kTiles, request);
+        assert(request.tag == "first" && request.variant == 1 && request.heuristic == "pdb");
+        assert(request.max_nodes == 0 && request.max_time == 0.0 && request.engine == "idastar");
+        assert(request.instance.tiles[0] == 14 && request.instance.tiles[15] == 3);
+
+        SolveRequest limited;
+        ParseSolveRequest("x variant=2 heuristic=md engine=astar max-nodes=1000 max-time=2.5" + kTiles, limited);
+        assert(limited.variant == 2 && limited.heuristic == "md" && limited.engine == "astar");
+        assert(limited.max_nodes == 1000 && limited.max_time == 2.5);
+
+        assert(Rejects(""));
+        assert(Rejects("x"));
+        assert(Rejects("x 0 1 2 3"));
+        assert(Rejects("x variant=3" + kTiles));
+        assert(Rejects("x variant=" + kTiles));
+        assert(Rejects("x variant=1a" + kTiles));
+        assert(Rejects("x heuristic=pdq" + kTiles));
+        assert(Rejects("x engine=bfs" + kTiles));
+        assert(Rejects("x max-nodes=-1" + kTiles));
+        assert(Rejects("x max-time=99999999999999999999999999999999999e999" + kTiles));
+        assert(Rejects("x depth=3" + kTiles));
+        assert(Rejects("x 0 1 2 3 4 5 6 7 8 9 10 11 12 13 15 14"));
+        std::cout << "Parse test passed\n";
+    }
+
+    void testPath() {
+        assert(FormatPath({}) == "");
+        assert(FormatPath({{Left, 1}, {Up, 2}, {Right, 1}, {Down, 3}}) == "L1,U2,R1,D3");
+        std::cout << "Path test passed\n";
+    }
+}
+
+int main() {
+    Test::testParse();
+    Test::testPath();
+    return 0;
+}
+
+// g++ -std=c++17 -O2 test_solve_request.cpp ../SolveRequest.cpp ../InstanceStream.cpp ../../Puzzle/Puzzle.cpp -o test_solve_request
@@ -0,0 +1,131 @@
+#ifndef VARIANT_H
+#define VARIANT_H
+
+#include "../Puzzle/Puzzle.h"
+#include <array>
+#include <cstdint>
+
+// One move of the blank: it travels from `from` to `target` in `count` cells
+// of `step` (-1, +1, -kCols or +kCols), and every tile it passes shifts one cell back
+// towards `from`.
+struct Move {
+    Action action;
+    int8_t from;
+    int8_t target;
+    int8_t step;
+    int8_t count;
+};
+
+struct MoveList {
+    std::array<Move, 8> moves;
+    int size;
+};
+
+// Board of the solver's inner loop: tiles plus the blank position. Goal is
+// tile i at position i (blank top-left), as in Puzzle. Moves carry their own
+// steps, so only the number of cells is a parameter.
+template <int kCells>
+struct BasicBoard {
+    std::array<int, kCells> tiles;
+    int blank;
+
+    void Apply(const Move& move) {
+        for (int p = move.from; p != move.target; p += move.step) {
+            tiles[p] = tiles[p + move.step];
+        }
+        tiles[move.target] = 0;
+        blank = move.target;
+    }
+
+    void Undo(const Move& move) {
+        for (int p = move.target; p != move.from; p -= move.step) {
+            tiles[p] = tiles[p - move.step];
+        }
+        tiles[move.from] = 0;
+        blank = move.from;
+    }
+
+    bool IsGoal() const {
+        for (int i = 0; i < kCells; ++i) {
+            if (tiles[i] != i) return false;
+        }
+        return true;
+    }
+};
+
+using Board = BasicBoard<16>;
+
+// Move set and cost model of a puzzle variant on a kRows x kCols board,
+// resolved at compile time so the search loop never asks which variant or
+// board it is solving.
+//   Variant<1>: single-tile moves in all four directions
+//   Variant<2>: single-tile vertical moves, horizontal slides of 1 to
+//               kCols-1 tiles (1-3 on the 15-puzzle)
+// Every move costs 1, including a multi-tile slide.
+//
+// Moves are listed per blank position in the order Puzzle::GetPossibleActions
+// returns them, so the search visits children in the same order as before.
+template <int kVariantNumber, int kRowCount = 4, int kColCount = 4>
+struct Variant {
+    static_assert(kVariantNumber == 1 || kVariantNumber == 2, "Unknown puzzle variant");
+
+    static const int kNumber = kVariantNumber;
+    static const int kRows = kRowCount;
+    static const int kCols = kColCount;
+    static const int kCells = kRows * kCols;
+    static const int kMaxSlide = (kVariantNumber == 1) ? 1 : kCols - 1;
+    static const int kMaxChildren = (kVariantNumber == 1) ? 4 : 2 + kCols - 1;
+    static_assert(kMaxChildren <= 8, "MoveList holds 8 moves");
+
+    using Board = BasicBoard<kCells>;
+    using Puzzle = BasicPuzzle<kRows, kCols>;
+
+    static int Cost(const Move&) { return 1; }
+
+    static const MoveList& Moves(int blank) { return kMoveTable[blank]; }
+
+private:
+    static constexpr Move MakeMove(Direction dir, int from, int steps) {
+        int step = (dir == Left) ? -1 : (dir == Right) ? 1 : (dir == Up) ? -kCols : kCols;
+        return Move{Action{dir, steps}, static_cast<int8_t>(from), static_cast<int8_t>(from + step * steps),
+                    static_cast<int8_t>(step), static_cast<int8_t>(steps)};
+    }
+
+    static constexpr std::array<MoveList, kCells> BuildMoveTable() {
+        std::array<MoveList, kCells> table{};
+        for (int blank = 0; blank < kCells; ++blank) {
+            MoveList& list = table[blank];
+            list.size = 0;
+            int row = blank / kCols, col = blank % kCols;
+            if (kVariantNumber == 1) {
+                if (col > 0) list.moves[list.size++] = MakeMove(Left, blank, 1);
+                if (col < kCols - 1) list.moves[list.size++] = MakeMove(Right, blank, 1);
+                if (row > 0) list.moves[list.size++] = MakeMove(Up, blank, 1);
+                if (row < kRows - 1) list.moves[list.size++] = MakeMove(Down, blank, 1);
+            } else {
+                if (row > 0) list.moves[list.size++] = MakeMove(Up, blank, 1);
+                if (row < kRows - 1) list.moves[list.size++] = MakeMove(Down, blank, 1);
+                for (int s = 1; s <= col; ++s) list.moves[list.size++] = MakeMove(Left, blank, s);
+                for (int s = 1; s <= kCols - 1 - col; ++s) list.moves[list.size++] = MakeMove(Right, blank, s);
+            }
+        }
+        return table;
+    }
+
+    static constexpr std::array<MoveList, kCells> kMoveTable = BuildMoveTable();
+};
+
+using Variant1 = Variant<1>;
+using Variant2 = Variant<2>;
+
+inline Direction Opposite(Direction dir) {
+    switch (dir) {
+        case Left:  return Right;
+        case Right: return Left;
+        case Up:    return Down;
+        case Down:  return Up;
+    }
+    return dir;
+}
+
+#endif // VARIANT_H
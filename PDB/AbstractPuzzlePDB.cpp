@@ -1,22 +1,26 @@
 #include "AbstractPuzzlePDB.h"
 
-AbstractPuzzlePDB::AbstractPuzzlePDB(
+template <int kRows, int kCols>
+BasicAbstractPuzzlePDB<kRows, kCols>::BasicAbstractPuzzlePDB(
     int variant,
     const std::unordered_set<int>& pattern
 ) : puzzle(CreateGoalState(pattern), variant) , pattern_tiles(pattern) {}
 
-AbstractPuzzlePDB::AbstractPuzzlePDB(
+template <int kRows, int kCols>
+BasicAbstractPuzzlePDB<kRows, kCols>::BasicAbstractPuzzlePDB(
     int variant,
     const std::unordered_set<int>& pattern,
-    const std::array<int, 16>& state
+    const Tiles& state
 ) : puzzle(state, variant), pattern_tiles(pattern) {}
 
 // Copy constructor
-AbstractPuzzlePDB::AbstractPuzzlePDB(const AbstractPuzzlePDB& other)
+template <int kRows, int kCols>
+BasicAbstractPuzzlePDB<kRows, kCols>::BasicAbstractPuzzlePDB(const BasicAbstractPuzzlePDB& other)
     : puzzle(other.puzzle), pattern_tiles(other.pattern_tiles) {}
 
 // Copy assignment operator
-AbstractPuzzlePDB& AbstractPuzzlePDB::operator=(const AbstractPuzzlePDB& other) {
+template <int kRows, int kCols>
+BasicAbstractPuzzlePDB<kRows, kCols>& BasicAbstractPuzzlePDB<kRows, kCols>::operator=(const BasicAbstractPuzzlePDB& other) {
     if (this != &other) { // Check for self-assignment
         puzzle = other.puzzle;
         pattern_tiles = other.pattern_tiles;
@@ -24,14 +28,15 @@ AbstractPuzzlePDB& AbstractPuzzlePDB::operator=(const AbstractPuzzlePDB& other)
     return *this;
 }
 
-std::array<int, 16> AbstractPuzzlePDB::CreateGoalState(const std::unordered_set<int>& pattern) {
-    std::array<int, 16> goal_tiles{};
-    for (int i = 0; i < 16; ++i) {
+template <int kRows, int kCols>
+typename BasicAbstractPuzzlePDB<kRows, kCols>::Tiles BasicAbstractPuzzlePDB<kRows, kCols>::CreateGoalState(const std::unordered_set<int>& pattern) {
+    Tiles goal_tiles{};
+    for (int i = 0; i < kCells; ++i) {
         goal_tiles[i] = -1; // Initialize all tiles to -1 (non-pattern)
     }
     for (int tile : pattern) {
-        // Ensure the tile is valid (0–15)
-        if (tile < 0 || tile > 15) {
+        // Ensure the tile is valid (0 to kCells-1)
+        if (tile < 0 || tile >= kCells) {
             throw std::out_of_range("Invalid tile value in pattern: " + std::to_string(tile));
         }
         // Compute goal position directly
@@ -39,8 +44,8 @@ std::array<int, 16> AbstractPuzzlePDB::CreateGoalState(const std::unordered_set<
     }
 
     std::cout << "Goal Tiles:";
-    for (int i = 0; i < 16; ++i) {
-        if (i % 4 == 0) std::cout << std::endl;
+    for (int i = 0; i < kCells; ++i) {
+        if (i % kCols == 0) std::cout << std::endl;
         std::cout << "\t" << goal_tiles[i];
     }
     std::cout << std::endl;
@@ -48,7 +53,8 @@ std::array<int, 16> AbstractPuzzlePDB::CreateGoalState(const std::unordered_set<
     return goal_tiles;
 }
 
-std::vector<std::pair<Action, std::vector<int>>> AbstractPuzzlePDB::GetPossibleActions() const {
+template <int kRows, int kCols>
+std::vector<std::pair<Action, std::vector<int>>> BasicAbstractPuzzlePDB<kRows, kCols>::GetPossibleActions() const {
     std::vector<std::pair<Action, std::vector<int>>> actions;
     const auto& tiles = puzzle.GetTiles();
     int blank_row = puzzle.GetBlankPosition().first;
@@ -63,13 +69,13 @@ std::vector<std::pair<Action, std::vector<int>>> AbstractPuzzlePDB::GetPossibleA
         }
     };
 
-    // Variant 2: Moving up to 3 tiles left or right
+    // Variant 2: Moving any number of tiles of the row left or right
     auto addMultiStepAction = [&](Direction dir, int steps) {
         std::vector<int> moved_pattern_tiles;
         for (int s = 1; s <= steps; ++s) {
             int tile = (dir == Left)
-                ? tiles[blank_row * 4 + (blank_col - s)]
-                : tiles[blank_row * 4 + (blank_col + s)];
+                ? tiles[blank_row * kCols + (blank_col - s)]
+                : tiles[blank_row * kCols + (blank_col + s)];
             if (pattern_tiles.count(tile)) {
                 moved_pattern_tiles.push_back(tile);
             }
@@ -78,19 +84,19 @@ std::vector<std::pair<Action, std::vector<int>>> AbstractPuzzlePDB::GetPossibleA
     };
         
     if (blank_col > 0) {
-        int tile = tiles[blank_row * 4 + (blank_col - 1)];
+        int tile = tiles[blank_row * kCols + (blank_col - 1)];
         addAction(Left, 1, tile);
     }
-    if (blank_col < 3) {
-        int tile = tiles[blank_row * 4 + (blank_col + 1)];
+    if (blank_col < kCols - 1) {
+        int tile = tiles[blank_row * kCols + (blank_col + 1)];
         addAction(Right, 1, tile);
     }
     if (blank_row > 0) {
-        int tile = tiles[(blank_row - 1) * 4 + blank_col];
+        int tile = tiles[(blank_row - 1) * kCols + blank_col];
         addAction(Up, 1, tile);
     }
-    if (blank_row < 3) {
-        int tile = tiles[(blank_row + 1) * 4 + blank_col];
+    if (blank_row < kRows - 1) {
+        int tile = tiles[(blank_row + 1) * kCols + blank_col];
         addAction(Down, 1, tile);
     }
 
@@ -101,7 +107,7 @@ std::vector<std::pair<Action, std::vector<int>>> AbstractPuzzlePDB::GetPossibleA
             addMultiStepAction(Left, s);
         }
 
-        int max_right = 3 - blank_col;
+        int max_right = kCols - 1 - blank_col;
         for (int s = 2; s <= max_right; ++s) {
             addMultiStepAction(Right, s);
         }
@@ -110,15 +116,16 @@ std::vector<std::pair<Action, std::vector<int>>> AbstractPuzzlePDB::GetPossibleA
     return actions;
 }
 
-bool AbstractPuzzlePDB::GoalTest() const {
+template <int kRows, int kCols>
+bool BasicAbstractPuzzlePDB<kRows, kCols>::GoalTest() const {
     // Only check pattern tiles' positions
     const auto& tiles = puzzle.GetTiles();
     for (int tile : pattern_tiles) {
         auto [gr, gc] = Puzzle::goal_positions.at(tile);
         bool found = false;
-        for (int i = 0; i < 16; ++i) {
+        for (int i = 0; i < kCells; ++i) {
             if (tiles[i] == tile) {
-                if (i/4 != gr || i%4 != gc) return false;
+                if (i/kCols != gr || i%kCols != gc) return false;
                 found = true;
                 break;
             }
@@ -128,26 +135,36 @@ bool AbstractPuzzlePDB::GoalTest() const {
     return true;
 }
 
-void AbstractPuzzlePDB::ApplyAction(Action action) {
+template <int kRows, int kCols>
+void BasicAbstractPuzzlePDB<kRows, kCols>::ApplyAction(Action action) {
     puzzle.ApplyAction(action);
 }
 
-void AbstractPuzzlePDB::UndoAction(Action action) {
+template <int kRows, int kCols>
+void BasicAbstractPuzzlePDB<kRows, kCols>::UndoAction(Action action) {
     puzzle.UndoAction(action);
 }
 
-std::array<int, 16> AbstractPuzzlePDB::GetAbstractState() const {
+template <int kRows, int kCols>
+typename BasicAbstractPuzzlePDB<kRows, kCols>::Tiles BasicAbstractPuzzlePDB<kRows, kCols>::GetAbstractState() const {
     return puzzle.GetTiles();
 }
 
-void AbstractPuzzlePDB::PrintPuzzle() const {
+template <int kRows, int kCols>
+void BasicAbstractPuzzlePDB<kRows, kCols>::PrintPuzzle() const {
     puzzle.PrintState();
 }
 
-int AbstractPuzzlePDB::GetVariant() const {
+template <int kRows, int kCols>
+int BasicAbstractPuzzlePDB<kRows, kCols>::GetVariant() const {
     return puzzle.GetVariant();
 }
 
-const std::unordered_set<int>& AbstractPuzzlePDB::GetPattern() const {
+template <int kRows, int kCols>
+const std::unordered_set<int>& BasicAbstractPuzzlePDB<kRows, kCols>::GetPattern() const {
     return pattern_tiles;
-}
\ No newline at end of file
+}
+
+template class BasicAbstractPuzzlePDB<3, 3>;
+template class BasicAbstractPuzzlePDB<4, 4>;
+template class BasicAbstractPuzzlePDB<5, 5>;
\ No newline at end of file
@@ -5,26 +5,35 @@
 #include <unordered_set>
 #include <array>
 
-class AbstractPuzzlePDB {
+// Abstract puzzle of a pattern on a kRows x kCols board: non-pattern tiles
+// are -1. Instantiated in AbstractPuzzlePDB.cpp for the board sizes of
+// BasicPuzzle; `AbstractPuzzlePDB` is the 4x4 one.
+template <int kRows, int kCols>
+class BasicAbstractPuzzlePDB {
+public:
+    using Puzzle = BasicPuzzle<kRows, kCols>;
+    using Tiles = typename Puzzle::Tiles;
+    static const int kCells = Puzzle::kCells;
+
 private:
     Puzzle puzzle; // Internal Puzzle instance
     std::unordered_set<int> pattern_tiles; // Tiles to track (e.g., {0-7})
 
     // Helper function to create goal state
-    std::array<int, 16> CreateGoalState(const std::unordered_set<int>& pattern);
+    Tiles CreateGoalState(const std::unordered_set<int>& pattern);
 
 public:
     // Constructor: Takes variant and pattern tiles
-    AbstractPuzzlePDB(int variant, const std::unordered_set<int>& pattern);
-    
+    BasicAbstractPuzzlePDB(int variant, const std::unordered_set<int>& pattern);
+
     // New constructor to initialize with a specific state and pattern
-    AbstractPuzzlePDB(int variant, const std::unordered_set<int>& pattern, const std::array<int, 16>& state);
+    BasicAbstractPuzzlePDB(int variant, const std::unordered_set<int>& pattern, const Tiles& state);
 
     // Copy constructor
-    AbstractPuzzlePDB(const AbstractPuzzlePDB& other);
+    BasicAbstractPuzzlePDB(const BasicAbstractPuzzlePDB& other);
 
     // Copy assignment operator
-    AbstractPuzzlePDB& operator=(const AbstractPuzzlePDB& other);
+    BasicAbstractPuzzlePDB& operator=(const BasicAbstractPuzzlePDB& other);
 
     // Overloaded methods for PDB generation
     std::vector<std::pair<Action, std::vector<int>>> GetPossibleActions() const;
@@ -33,10 +42,16 @@ public:
     void UndoAction(Action action);
 
     // Convert state to a canonical form (for PDB hashing)
-    std::array<int, 16> GetAbstractState() const;
+    Tiles GetAbstractState() const;
     int GetVariant() const;
     void PrintPuzzle() const;
     const std::unordered_set<int>& GetPattern() const;
 };
 
+extern template class BasicAbstractPuzzlePDB<3, 3>;
+extern template class BasicAbstractPuzzlePDB<4, 4>;
+extern template class BasicAbstractPuzzlePDB<5, 5>;
+
+using AbstractPuzzlePDB = BasicAbstractPuzzlePDB<4, 4>;
+
 #endif // ABSTRACT_PUZZLE_PDB_H
\ No newline at end of file
@@ -0,0 +1,100 @@
+#include "../Search/PDBFormat.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Lossy min compression of a raw PDB from ParallelPDBGenerator. Every run of
+// `factor` adjacent ranks becomes one entry holding the run's minimum, so the
+// table shrinks by the factor and stays admissible (an entry never exceeds
+// any of the states it stands for). The last pattern tile has rank weight 1:
+// a factor of cells - k + 1 (k pattern tiles) merges exactly the entries that
+// differ only in that tile's position, e.g. 10 for a 7-tile 4x4 pattern.
+//
+//   CompressPDB --factor 10 pdb_v1_0-7.bin pdb_v1_0-7.min10.bin
+//
+// The solvers read the result like any PDB file; the header tells them to
+// look rank r up at r / factor. The variant is carried over from the input.
+
+// Writes the min-compressed table of a raw one, reading the input in chunks
+// of whole groups. Returns false on I/O errors or an input that is not a raw
+// table with a current header.
+bool Compress(const std::string& input, const std::string& output, uint64_t factor) {
+    std::ifstream in(input, std::ios::binary);
+    if (!in) {
+        std::cerr << "Failed to open " << input << "\n";
+        return false;
+    }
+    PDBFormat::Header header;
+    const PDBFormat::HeaderStatus header_status = PDBFormat::ReadHeader(in, header);
+    if (header_status == PDBFormat::HeaderStatus::OtherVersion) {
+        std::cerr << input << " has an older PDB header; CompressPDB needs a raw table\n";
+        return false;
+    }
+    if (header_status == PDBFormat::HeaderStatus::None) {
+        std::cerr << input << " has no PDB header; regenerate it with ParallelPDBGenerator\n";
+        return false;
+    }
+    if (static_cast<PDBFormat::Encoding>(header.encoding) != PDBFormat::Encoding::Raw) {
+        std::cerr << input << " is " << PDBFormat::ToString(static_cast<PDBFormat::Encoding>(header.encoding))
+                  << " encoded; CompressPDB needs a raw table\n";
+        return false;
+    }
+    const uint64_t num_states = header.num_states;
+    const int variant = static_cast<int>(header.variant);
+
+    std::ofstream out(output, std::ios::binary);
+    if (!out) {
+        std::cerr << "Failed to open " << output << "\n";
+        return false;
+    }
+    PDBFormat::WriteHeader(out, PDBFormat::Encoding::Min, variant, num_states, 0, factor);
+
+    const uint64_t groups_per_chunk = std::max<uint64_t>(1, (uint64_t(1) << 24) / factor);
+    std::vector<uint8_t> raw(groups_per_chunk * factor);
+    std::vector<uint8_t> compressed(groups_per_chunk);
+    for (uint64_t first = 0; first < num_states; first += raw.size()) {
+        const uint64_t count = std::min<uint64_t>(raw.size(), num_states - first);
+        in.read(reinterpret_cast<char*>(raw.data()), count);
+        if (!in) {
+            std::cerr << "Failed to read " << input << "\n";
+            return false;
+        }
+        const uint64_t groups = PDBFormat::MinBytes(count, factor);
+        for (uint64_t g = 0; g < groups; ++g) {
+            const auto begin = raw.begin() + g * factor;
+            compressed[g] = *std::min_element(begin, begin + std::min<uint64_t>(factor, count - g * factor));
+        }
+        out.write(reinterpret_cast<const char*>(compressed.data()), groups);
+    }
+    if (!out) {
+        std::cerr << "Failed to write " << output << "\n";
+        return false;
+    }
+    std::cout << input << ": " << num_states << " entries -> " << output << ": "
+              << PDBFormat::MinBytes(num_states, factor) << " entries (factor " << factor << ")\n";
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    uint64_t factor = 0;
+    std::vector<std::string> files;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--factor") == 0 && i + 1 < argc) {
+            factor = std::strtoull(argv[++i], nullptr, 10);
+        } else if (argv[i][0] != '-') {
+            files.push_back(argv[i]);
+        } else {
+            files.clear();
+            break;
+        }
+    }
+    if (factor < 1 || files.size() != 2) {
+        std::cerr << "Usage: " << argv[0] << " --factor <n> <raw input> <output>\n";
+        return 1;
+    }
+    return Compress(files[0], files[1], factor) ? 0 : 1;
+}
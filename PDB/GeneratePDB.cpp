@@ -1,242 +1,508 @@
-#include "GeneratePDB.h"
-#include <algorithm>
-#include <fstream>
-#include <iostream>
-
-GeneratePDB::GeneratePDB(const std::unordered_set<int>& pattern, int variant, const std::string& filepath)
-    : pattern(pattern), variant(variant), filepath(filepath) {
-        
-    sorted_pattern.assign(pattern.begin(), pattern.end());
-    std::sort(sorted_pattern.begin(), sorted_pattern.end());
-
-    // For closed set: pattern + 0
-    sorted_closed_pattern.assign(sorted_pattern.begin(), sorted_pattern.end());
-}
-
-uint64_t GeneratePDB::compute_rank(const std::vector<int>& abstract_state, int extended = 0) {
-    uint64_t rank = 0;
-    uint64_t used_mask = 0;
-
-    int k;
-    k = !extended ? sorted_pattern.size() : sorted_closed_pattern.size();
-
-    for (int i = 0; i < k; ++i) {
-        int current_pos = abstract_state[i];
-        uint64_t mask = (1ULL << current_pos) - 1;
-        int used_below = __builtin_popcountll(used_mask & mask);
-        int count = current_pos - used_below;
-        
-        rank = rank + (!extended ? (count * multipliers[i]) : (count * closed_multipliers[i]));
-
-        used_mask |= 1ULL << current_pos;
-    }
-    return rank;
-}
-
-std::vector<int> GeneratePDB::UnrankState(uint64_t rank, bool extended = false) const {
-    std::vector<int> abstract_state;
-    uint64_t used_mask = 0;
-    int k = extended ? sorted_closed_pattern.size() : sorted_pattern.size();
-    const std::vector<uint64_t>& multipliers_ref = extended ? closed_multipliers : multipliers;
-
-    for (int i = 0; i < k; ++i) {
-        uint64_t multiplier = multipliers_ref[i];
-        uint64_t count = rank / multiplier;
-        rank %= multiplier;
-
-        // Find the count-th unused position
-        int pos = 0;
-        int remaining = count + 1;  // Number of unused positions to skip
-        while (pos < 16 && remaining > 0) {
-            if (!(used_mask & (1ULL << pos))) {
-                --remaining;
-                if (remaining == 0) break;
-            }
-            ++pos;
-        }
-
-        if (pos >= 16) {
-            throw std::runtime_error("Invalid rank: position out of bounds");
-        }
-
-        abstract_state.push_back(pos);
-        used_mask |= (1ULL << pos);
-    }
-
-    return abstract_state;
-}
-
-std::array<int, 16> GeneratePDB::ReconstructState(const std::vector<int>& abstract_state_with_0) const {
-    std::array<int, 16> state;
-    state.fill(-1);  // Initialize all tiles to -1 (abstracted)
-
-    // Assign positions for pattern tiles and 0
-    for (size_t i = 0; i < abstract_state_with_0.size(); ++i) {
-        int pos = abstract_state_with_0[i];
-        int tile = sorted_closed_pattern[i];  // Includes 0
-        state[pos] = tile;
-    }
-
-    return state;
-}
-
-std::vector<int> GeneratePDB::GetDual(const std::array<int, 16>& state, int extended = 0) const {
-    std::vector<int> abstract_state;
-    const std::vector<int>& temp_pattern = (!extended) ? sorted_pattern : sorted_closed_pattern;
-    for (int tile : temp_pattern) {
-        for (int pos = 0; pos < 16; ++pos) {
-            if (state[pos] == tile) {
-                abstract_state.push_back(pos);
-                break;
-            }
-        }
-    }
-    return abstract_state;
-}
-
-void GeneratePDB::PreComputeMultipliers(int k) {
-    // Precompute multipliers for ranking
-    multipliers.resize(k);
-    for (int i = 0; i < k; ++i) {
-        int remaining = k - i - 1;
-        multipliers[i] = 1;
-        for (int j = 0; j < remaining; ++j) {
-            multipliers[i] *= (16 - i - 1 - j);
-        }
-    }
-
-    int k_plus_1 = k + 1;
-    closed_multipliers.resize(k_plus_1);
-    for (int i = 0; i < k_plus_1; ++i) {
-        int remaining = k_plus_1 - i - 1;
-        closed_multipliers[i] = 1;
-        for (int j = 0; j < remaining; ++j) {
-            closed_multipliers[i] *= (16 - i - 1 - j);
-        }
-    }
-}
-
-void GeneratePDB::BuildPDB() {
-    AbstractPuzzlePDB pdb_puzzle(variant, pattern);
-    RemoveElemFromPattern(0);
-    int k = sorted_pattern.size();
-    int k_plus_1 = k+1;
-
-    PreComputeMultipliers(k);
-
-    // Calculate number of permutations (16Pk)
-    uint64_t num_states = 1;
-    for (int i = 0; i < k; ++i) {
-        num_states *= (16 - i);
-    }
-    pdb_vector.resize(num_states, 0xFF); // 0xFF indicates unvisited
-
-    // Resize closed_set_bitvector (16P(k_plus_1))
-    uint64_t closed_num_states = 1;
-    for (int i = 0; i < k_plus_1; ++i) {
-        closed_num_states *= (16 - i);
-    }
-    closed_set_bitvector.resize(closed_num_states, false);
-
-    std::queue<uint64_t> q;
-
-    auto initial_concrete = pdb_puzzle.GetAbstractState();
-
-    auto initial_pdb_abstract = GetDual(initial_concrete, 0);
-    auto initial_closet_abstract = GetDual(initial_concrete, 1);
-
-    uint64_t initial_pdb_rank = compute_rank(initial_pdb_abstract, 0);
-    uint64_t initial_closet_rank = compute_rank(initial_closet_abstract, 1);
-
-    pdb_vector[initial_pdb_rank] = 0;
-    closed_set_bitvector[initial_closet_rank] = true;
-    q.push(initial_closet_rank);
-
-    long long nodes_expanded = 0;
-
-    while (!q.empty()) {
-        uint64_t current_closet_rank = q.front();
-        // auto current_concrete = q.front();
-        q.pop();
-
-        // Reconstruct the full state from the rank
-        auto current_closet_abstract = UnrankState(current_closet_rank, true);
-        auto current_concrete = ReconstructState(current_closet_abstract);
-
-        auto current_pdb_abstract = GetDual(current_concrete, 0);
-
-        uint64_t current_pdb_rank = compute_rank(current_pdb_abstract, 0);
-
-        int current_cost = pdb_vector[current_pdb_rank];
-
-        ++nodes_expanded;
-        if (nodes_expanded % 10000 == 0)
-            std::cout << "\rNodes expanded: " << nodes_expanded << std::flush;
-
-        AbstractPuzzlePDB temp_puzzle(variant, pattern, current_concrete);
-        auto actions = temp_puzzle.GetPossibleActions();
-
-        for (const auto& [action, moved_tiles] : actions) {
-            temp_puzzle.ApplyAction(action);
-            auto new_concrete = temp_puzzle.GetAbstractState();
-
-            auto new_pdb_abstract = GetDual(new_concrete, 0);
-            auto new_closet_abstract = GetDual(new_concrete, 1);
-            uint64_t new_closet_rank = compute_rank(new_closet_abstract, 1);
-
-            if (!closed_set_bitvector[new_closet_rank]) {
-                size_t moved_tiles_size = moved_tiles.size();
-                if (moved_tiles_size != 0) {
-                    uint64_t new_pdb_rank = compute_rank(new_pdb_abstract, 0);
-                    int new_cost;
-                    new_cost = (variant == 1) ? 1 :  static_cast<int>( (1 / moved_tiles_size) * 6 );
-                    pdb_vector[new_pdb_rank] = current_cost + new_cost;
-                }
-                closed_set_bitvector[new_closet_rank] = true;
-                q.push(new_closet_rank);
-            }
-
-            temp_puzzle.UndoAction(action);
-        }
-    }
-    std::cout << "\rTotal Nodes expanded: " << nodes_expanded << std::endl;
-
-    std::cout << "\nPDB built with " << num_states << " entries" << std::endl;
-}
-
-void GeneratePDB::SaveToFile() const {
-    std::ofstream file(filepath, std::ios::binary);
-    if (!file) {
-        std::cerr << "Error opening file: " << filepath << std::endl;
-        return;
-    }
-
-    file.write(reinterpret_cast<const char*>(pdb_vector.data()), pdb_vector.size());
-    std::cout << "PDB saved to " << filepath << std::endl;
-
-    // Release memory
-    const_cast<GeneratePDB*>(this)->ClearMemory();
-
-}
-
-void GeneratePDB::ClearMemory() {
-    pdb_vector.clear();
-    pdb_vector.shrink_to_fit();
-    multipliers.clear();
-    multipliers.shrink_to_fit();
-
-    closed_set_bitvector.clear();
-    closed_set_bitvector.shrink_to_fit();
-    closed_multipliers.clear();
-    closed_multipliers.shrink_to_fit();
-    std::cout << "Memory released for pdb.\n";
-}
-
-void GeneratePDB::RemoveElemFromPattern(int val) {
-    pattern.erase(val);
-    auto it = std::lower_bound(sorted_pattern.begin(), sorted_pattern.end(), val);
-
-    if (it != sorted_pattern.end() && *it == val) {
-        sorted_pattern.erase(it);
-    }
-}
+#include "GeneratePDB.h"
+#include "../Search/Ranking.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+template <int kRows, int kCols>
+BasicGeneratePDB<kRows, kCols>::BasicGeneratePDB(const std::unordered_set<int>& pattern, int variant, const std::string& filepath,
+                                                 PDBFormat::Encoding encoding)
+    : pattern(pattern), variant(variant), filepath(filepath), encoding(encoding) {
+    if (encoding != PDBFormat::Encoding::Raw && variant != 1) {
+        // Slides change a variant-2 entry by more than one step, and its
+        // sixths of a move are no Manhattan distance plus an even excess
+        std::cerr << PDBFormat::ToString(encoding) << " PDBs are variant 1 only, saving " << filepath << " raw"
+                  << std::endl;
+        this->encoding = PDBFormat::Encoding::Raw;
+    }
+        
+    sorted_pattern.assign(pattern.begin(), pattern.end());
+    std::sort(sorted_pattern.begin(), sorted_pattern.end());
+
+    // For closed set: pattern + 0
+    sorted_closed_pattern.assign(sorted_pattern.begin(), sorted_pattern.end());
+}
+
+template <int kRows, int kCols>
+uint64_t BasicGeneratePDB<kRows, kCols>::compute_rank(const std::vector<int>& abstract_state, int extended) {
+    uint64_t rank = 0;
+    uint64_t used_mask = 0;
+
+    int k;
+    k = !extended ? sorted_pattern.size() : sorted_closed_pattern.size();
+
+    for (int i = 0; i < k; ++i) {
+        int current_pos = abstract_state[i];
+        uint64_t mask = (1ULL << current_pos) - 1;
+        int used_below = __builtin_popcountll(used_mask & mask);
+        int count = current_pos - used_below;
+        
+        rank = rank + (!extended ? (count * multipliers[i]) : (count * closed_multipliers[i]));
+
+        used_mask |= 1ULL << current_pos;
+    }
+    return rank;
+}
+
+template <int kRows, int kCols>
+std::vector<int> BasicGeneratePDB<kRows, kCols>::UnrankState(uint64_t rank, bool extended) const {
+    std::vector<int> abstract_state;
+    uint64_t used_mask = 0;
+    int k = extended ? sorted_closed_pattern.size() : sorted_pattern.size();
+    const std::vector<uint64_t>& multipliers_ref = extended ? closed_multipliers : multipliers;
+
+    for (int i = 0; i < k; ++i) {
+        uint64_t multiplier = multipliers_ref[i];
+        uint64_t count = rank / multiplier;
+        rank %= multiplier;
+
+        // Find the count-th unused position
+        int pos = 0;
+        int remaining = count + 1;  // Number of unused positions to skip
+        while (pos < kCells && remaining > 0) {
+            if (!(used_mask & (1ULL << pos))) {
+                --remaining;
+                if (remaining == 0) break;
+            }
+            ++pos;
+        }
+
+        if (pos >= kCells) {
+            throw std::runtime_error("Invalid rank: position out of bounds");
+        }
+
+        abstract_state.push_back(pos);
+        used_mask |= (1ULL << pos);
+    }
+
+    return abstract_state;
+}
+
+template <int kRows, int kCols>
+typename BasicGeneratePDB<kRows, kCols>::Tiles BasicGeneratePDB<kRows, kCols>::ReconstructState(const std::vector<int>& abstract_state_with_0) const {
+    Tiles state;
+    state.fill(-1);  // Initialize all tiles to -1 (abstracted)
+
+    // Assign positions for pattern tiles and 0
+    for (size_t i = 0; i < abstract_state_with_0.size(); ++i) {
+        int pos = abstract_state_with_0[i];
+        int tile = sorted_closed_pattern[i];  // Includes 0
+        state[pos] = tile;
+    }
+
+    return state;
+}
+
+template <int kRows, int kCols>
+std::vector<int> BasicGeneratePDB<kRows, kCols>::GetDual(const Tiles& state, int extended) const {
+    std::vector<int> abstract_state;
+    const std::vector<int>& temp_pattern = (!extended) ? sorted_pattern : sorted_closed_pattern;
+    for (int tile : temp_pattern) {
+        for (int pos = 0; pos < kCells; ++pos) {
+            if (state[pos] == tile) {
+                abstract_state.push_back(pos);
+                break;
+            }
+        }
+    }
+    return abstract_state;
+}
+
+template <int kRows, int kCols>
+void BasicGeneratePDB<kRows, kCols>::PreComputeMultipliers(int k) {
+    // Precompute multipliers for ranking
+    multipliers.resize(k);
+    for (int i = 0; i < k; ++i) {
+        int remaining = k - i - 1;
+        multipliers[i] = 1;
+        for (int j = 0; j < remaining; ++j) {
+            multipliers[i] *= (kCells - i - 1 - j);
+        }
+    }
+
+    int k_plus_1 = k + 1;
+    closed_multipliers.resize(k_plus_1);
+    for (int i = 0; i < k_plus_1; ++i) {
+        int remaining = k_plus_1 - i - 1;
+        closed_multipliers[i] = 1;
+        for (int j = 0; j < remaining; ++j) {
+            closed_multipliers[i] *= (kCells - i - 1 - j);
+        }
+    }
+}
+
+template <int kRows, int kCols>
+void BasicGeneratePDB<kRows, kCols>::BuildPDB() {
+    AbstractPuzzle pdb_puzzle(variant, pattern);
+    RemoveElemFromPattern(0);
+    int k = sorted_pattern.size();
+    int k_plus_1 = k+1;
+
+    PreComputeMultipliers(k);
+
+    // Calculate number of permutations (kCells P k)
+    uint64_t num_states = 1;
+    for (int i = 0; i < k; ++i) {
+        num_states *= (kCells - i);
+    }
+    pdb_vector.resize(num_states, 0xFF); // 0xFF indicates unvisited
+    HugePages::Backing pdb_backing = HugePages::LastBacking();
+
+    // Resize closed_set_bitvector (kCells P (k_plus_1))
+    uint64_t closed_num_states = 1;
+    for (int i = 0; i < k_plus_1; ++i) {
+        closed_num_states *= (kCells - i);
+    }
+    closed_set_bits.resize((closed_num_states + 63) / 64, 0);
+    std::cout << "PDB table on " << HugePages::ToString(pdb_backing) << ", closed set on "
+              << HugePages::ToString(HugePages::LastBacking()) << std::endl;
+
+    auto initial_concrete = pdb_puzzle.GetAbstractState();
+
+    auto initial_closet_abstract = GetDual(initial_concrete, 1);
+
+    uint64_t initial_closet_rank = compute_rank(initial_closet_abstract, 1);
+
+    // Dial's algorithm over the closed (pattern + blank) states. A move that
+    // shifts pattern tiles costs 1 (variant 2: the pattern's share of the
+    // slide in sixths), a blank move past other tiles costs 0, so a plain
+    // FIFO would close states too early.
+    // buckets[d] holds states first reached with cost d through a costly
+    // move, possibly several times; they are closed when taken from the
+    // bucket. States reached by a free move are closed at once, since every
+    // cheaper state is already closed. The first closed state of a pattern
+    // rank sets its entry: the exact minimum over the blank positions.
+    std::vector<std::queue<uint64_t>> buckets(1);
+    std::queue<uint64_t> level_queue; // Closed states of the current level, to expand
+
+    closed_set_bits[initial_closet_rank >> 6] |= 1ULL << (initial_closet_rank & 63);
+    level_queue.push(initial_closet_rank);
+
+    nodes_expanded = 0;
+
+    // Children of the current node: they are ranked together (Ranking lanes,
+    // one per child) and their closed-set words prefetched before any is
+    // checked. Patterns whose multipliers exceed 32 bits rank one at a time.
+    struct Successor {
+        Tiles concrete;
+        uint64_t closet_rank;
+        int cost;
+    };
+    std::vector<Successor> successors;
+    std::array<int, kCells> closed_row;  // Row of each closed-pattern tile in the ranking lanes
+    closed_row.fill(-1);
+    for (int i = 0; i < k_plus_1; ++i) closed_row[sorted_closed_pattern[i]] = i;
+    const bool batch_ranking = closed_multipliers[0] <= UINT32_MAX;
+    Ranking::Lanes lanes;
+    uint64_t ranks[Ranking::kLanes];
+    for (int i = 0; i < k_plus_1; ++i) {
+        for (int c = 0; c < Ranking::kLanes; ++c) lanes.multipliers[i][c] = static_cast<uint32_t>(closed_multipliers[i]);
+    }
+
+    size_t level = 0;
+    while (true) {
+        if (level_queue.empty()) {
+            // Close the next unclosed state of this level's bucket, or move on
+            // to the next level
+            while (level < buckets.size() && buckets[level].empty()) {
+                std::queue<uint64_t>().swap(buckets[level]); // Release its blocks
+                ++level;
+            }
+            if (level == buckets.size()) break;
+            const uint64_t rank = buckets[level].front();
+            buckets[level].pop();
+            uint64_t& closed_word = closed_set_bits[rank >> 6];
+            const uint64_t closed_bit = 1ULL << (rank & 63);
+            if (!(closed_word & closed_bit)) {
+                closed_word |= closed_bit;
+                level_queue.push(rank);
+            }
+            continue;
+        }
+        uint64_t current_closet_rank = level_queue.front();
+        level_queue.pop();
+
+        // Reconstruct the full state from the rank
+        auto current_closet_abstract = UnrankState(current_closet_rank, true);
+        auto current_concrete = ReconstructState(current_closet_abstract);
+
+        auto current_pdb_abstract = GetDual(current_concrete, 0);
+
+        uint64_t current_pdb_rank = compute_rank(current_pdb_abstract, 0);
+
+        // Entries are bytes; deeper levels (variant-2 sixths) are capped, which
+        // only lowers them
+        if (pdb_vector[current_pdb_rank] == 0xFF) {
+            pdb_vector[current_pdb_rank] = static_cast<uint8_t>(std::min<size_t>(level, 0xFE));
+        }
+
+        ++nodes_expanded;
+        if (nodes_expanded % 10000 == 0)
+            std::cout << "\rNodes expanded: " << nodes_expanded << std::flush;
+
+        AbstractPuzzle temp_puzzle(variant, pattern, current_concrete);
+        auto actions = temp_puzzle.GetPossibleActions();
+
+        successors.clear();
+        for (const auto& [action, moved_tiles] : actions) {
+            // A variant-2 slide of n tiles charges 6 / n sixths per pattern
+            // tile it moves (rounded down on 5x5), so the databases of a
+            // partition add up to at most one move per slide
+            int cost = 0;
+            if (!moved_tiles.empty()) {
+                cost = (variant == 1) ? 1 : static_cast<int>(moved_tiles.size()) * 6 / action.steps;
+            }
+            temp_puzzle.ApplyAction(action);
+            successors.push_back(Successor{temp_puzzle.GetAbstractState(), 0, cost});
+            temp_puzzle.UndoAction(action);
+        }
+
+        for (size_t first = 0; batch_ranking && first < successors.size(); first += Ranking::kLanes) {
+            const int count = static_cast<int>(std::min<size_t>(Ranking::kLanes, successors.size() - first));
+            for (int c = 0; c < count; ++c) {
+                const Tiles& concrete = successors[first + c].concrete;
+                for (int pos = 0; pos < kCells; ++pos) {
+                    if (concrete[pos] >= 0) lanes.positions[closed_row[concrete[pos]]][c] = pos;
+                }
+            }
+            Ranking::Rank(lanes, k_plus_1, (1u << count) - 1, ranks);
+            for (int c = 0; c < count; ++c) {
+                successors[first + c].closet_rank = ranks[c];
+                __builtin_prefetch(&closed_set_bits[ranks[c] >> 6]);
+            }
+        }
+        for (size_t s = 0; !batch_ranking && s < successors.size(); ++s) {
+            successors[s].closet_rank = compute_rank(GetDual(successors[s].concrete, 1), 1);
+            __builtin_prefetch(&closed_set_bits[successors[s].closet_rank >> 6]);
+        }
+
+        for (const auto& successor : successors) {
+            uint64_t& closed_word = closed_set_bits[successor.closet_rank >> 6];
+            const uint64_t closed_bit = 1ULL << (successor.closet_rank & 63);
+            if (!(closed_word & closed_bit)) {
+                const int new_cost = successor.cost;
+                if (new_cost == 0) {
+                    closed_word |= closed_bit;
+                    level_queue.push(successor.closet_rank);
+                } else {
+                    if (buckets.size() <= level + new_cost) buckets.resize(level + new_cost + 1);
+                    buckets[level + new_cost].push(successor.closet_rank);
+                }
+            }
+        }
+    }
+    std::cout << "\rTotal Nodes expanded: " << nodes_expanded << std::endl;
+
+    std::cout << "\nPDB built with " << num_states << " entries" << std::endl;
+    if (encoding == PDBFormat::Encoding::Mod) MeasureModulus();
+    if (encoding == PDBFormat::Encoding::Delta) ToExcess();
+}
+
+// Replaces every entry by (entry - Manhattan distance of the pattern tiles)
+// / 2. A move of a pattern tile changes both by one and a blank move
+// neither, so the difference is even. Unreachable ranks get 0.
+template <int kRows, int kCols>
+void BasicGeneratePDB<kRows, kCols>::ToExcess() {
+    for (uint64_t rank = 0; rank < pdb_vector.size(); ++rank) {
+        uint8_t& value = pdb_vector[rank];
+        if (value == 0xFF) {
+            value = 0;
+            continue;
+        }
+        const std::vector<int> state = UnrankState(rank, false);
+        int manhattan = 0;
+        for (size_t i = 0; i < state.size(); ++i) {
+            manhattan += std::abs(state[i] / kCols - sorted_pattern[i] / kCols) +
+                         std::abs(state[i] % kCols - sorted_pattern[i] % kCols);
+        }
+        const int excess = value - manhattan;
+        if (excess < 0 || excess % 2 != 0 || excess / 2 >= PDBFormat::kDeltaSymbols) {
+            throw std::runtime_error("PDB entry " + std::to_string(value) + " is no Manhattan distance " +
+                                     std::to_string(manhattan) + " plus a small even excess");
+        }
+        value = static_cast<uint8_t>(excess / 2);
+    }
+}
+
+// Calls visit(rank) for every pattern state one pattern-tile step away from
+// rank: a tile moving to an adjacent cell free of pattern tiles
+template <int kRows, int kCols>
+template <typename Visit>
+void BasicGeneratePDB<kRows, kCols>::ForEachNeighbour(uint64_t rank, Visit&& visit) {
+    std::vector<int> state = UnrankState(rank, false);
+    uint64_t occupied = 0;
+    for (int pos : state) occupied |= 1ULL << pos;
+    for (size_t i = 0; i < state.size(); ++i) {
+        const int from = state[i];
+        const int row = from / kCols;
+        const int col = from % kCols;
+        const int targets[4] = {row > 0 ? from - kCols : -1, row < kRows - 1 ? from + kCols : -1,
+                                col > 0 ? from - 1 : -1, col < kCols - 1 ? from + 1 : -1};
+        for (int to : targets) {
+            if (to < 0 || (occupied & (1ULL << to))) continue;
+            state[i] = to;
+            visit(compute_rank(state, 0));
+        }
+        state[i] = from;
+    }
+}
+
+// Exact entries can differ by more than one between neighbouring pattern
+// states: the pattern tiles may shut the blank out of the region holding the
+// cheapest blank position. The largest difference D fixes the modulus 2D + 1,
+// the fewest residues that still tell the differences -D..D apart.
+template <int kRows, int kCols>
+void BasicGeneratePDB<kRows, kCols>::MeasureModulus() {
+    int max_difference = 1;
+    for (uint64_t rank = 0; rank < pdb_vector.size(); ++rank) {
+        const int value = pdb_vector[rank];
+        if (value == 0xFF) continue;
+        ForEachNeighbour(rank, [&](uint64_t neighbour) {
+            if (pdb_vector[neighbour] != 0xFF) max_difference = std::max(max_difference, value - pdb_vector[neighbour]);
+        });
+    }
+    modulus = 2 * max_difference + 1;
+    if (PDBFormat::ModBits(modulus) > PDBFormat::kMaxModBits) {
+        throw std::runtime_error("PDB entries of neighbouring states differ by " + std::to_string(max_difference) +
+                                 ", too much for a mod encoding");
+    }
+    std::cout << "Neighbouring entries differ by at most " << max_difference << ": h mod " << modulus << " in "
+              << PDBFormat::ModBits(modulus) << " bits per entry" << std::endl;
+}
+
+template <int kRows, int kCols>
+void BasicGeneratePDB<kRows, kCols>::SaveToFile() const {
+    std::ofstream file(filepath, std::ios::binary);
+    if (!file) {
+        std::cerr << "Error opening file: " << filepath << std::endl;
+        return;
+    }
+
+    if (encoding == PDBFormat::Encoding::Mod) {
+        // Codes of `bits` bits, written in chunks of whole bytes
+        const int bits = PDBFormat::ModBits(modulus);
+        const uint8_t unreachable = PDBFormat::ModUnreachable(bits);
+        PDBFormat::WriteHeader(file, encoding, variant, pdb_vector.size(), modulus);
+        std::vector<uint8_t> packed;
+        const uint64_t chunk = uint64_t(8) << 20;
+        for (uint64_t first = 0; first < pdb_vector.size(); first += chunk) {
+            const uint64_t last = std::min<uint64_t>(pdb_vector.size(), first + chunk);
+            packed.assign(PDBFormat::ModBytes(last - first, bits), 0);
+            for (uint64_t rank = first; rank < last; ++rank) {
+                const uint8_t value = pdb_vector[rank];
+                const uint16_t code = (value == 0xFF) ? unreachable : value % modulus;
+                const uint64_t bit = (rank - first) * bits;
+                uint16_t two;
+                std::memcpy(&two, &packed[bit >> 3], sizeof(two));
+                two |= code << (bit & 7);
+                std::memcpy(&packed[bit >> 3], &two, sizeof(two));
+            }
+            file.write(reinterpret_cast<const char*>(packed.data()), packed.size() - 1);
+        }
+        file.put(0); // The padding byte of PDBFormat::ModBytes
+    } else if (encoding == PDBFormat::Encoding::Delta) {
+        SaveDeltaBlocks(file);
+    } else {
+        PDBFormat::WriteHeader(file, encoding, variant, pdb_vector.size());
+        file.write(reinterpret_cast<const char*>(pdb_vector.data()), pdb_vector.size());
+    }
+    std::cout << "PDB saved to " << filepath << " (" << PDBFormat::ToString(encoding) << ")" << std::endl;
+
+    // Release memory
+    const_cast<BasicGeneratePDB*>(this)->ClearMemory();
+
+}
+
+// Codes the excesses from ToExcess in 64-byte blocks of a fixed number of
+// ranks: symbols ordered by frequency, symbol s as s one bits and a zero.
+// The ranks per block are the most for which every block fits.
+template <int kRows, int kCols>
+void BasicGeneratePDB<kRows, kCols>::SaveDeltaBlocks(std::ofstream& file) const {
+    std::array<uint64_t, PDBFormat::kDeltaSymbols> counts{};
+    for (uint64_t rank = 0; rank < pdb_vector.size(); ++rank) ++counts[pdb_vector[rank]];
+    std::array<uint8_t, PDBFormat::kDeltaSymbols> symbols; // Excess of each code, most frequent first
+    for (int s = 0; s < PDBFormat::kDeltaSymbols; ++s) symbols[s] = static_cast<uint8_t>(s);
+    std::stable_sort(symbols.begin(), symbols.end(), [&](uint8_t a, uint8_t b) { return counts[a] > counts[b]; });
+    std::array<int, PDBFormat::kDeltaSymbols> code_bits; // Of each excess
+    for (int s = 0; s < PDBFormat::kDeltaSymbols; ++s) code_bits[symbols[s]] = s + 1;
+
+    const uint64_t block_bits = PDBFormat::kDeltaBlockBytes * 8;
+    auto fits = [&](uint64_t block_ranks) {
+        for (uint64_t first = 0; first < pdb_vector.size(); first += block_ranks) {
+            const uint64_t last = std::min<uint64_t>(pdb_vector.size(), first + block_ranks);
+            uint64_t bits = 0;
+            for (uint64_t rank = first; rank < last && bits <= block_bits; ++rank) bits += code_bits[pdb_vector[rank]];
+            if (bits > block_bits) return false;
+        }
+        return true;
+    };
+    // Fitting is close to monotone in the block size: bisect, then step
+    // down to a size that fits
+    uint64_t low = 1;
+    uint64_t high = block_bits;
+    while (low < high) {
+        const uint64_t mid = (low + high + 1) / 2;
+        if (fits(mid)) {
+            low = mid;
+        } else {
+            high = mid - 1;
+        }
+    }
+    uint64_t block_ranks = low;
+    while (block_ranks > 1 && !fits(block_ranks)) --block_ranks;
+
+    PDBFormat::WriteHeader(file, encoding, variant, pdb_vector.size(), 0, block_ranks, symbols.data());
+    const uint64_t num_blocks = (pdb_vector.size() + block_ranks - 1) / block_ranks;
+    std::vector<uint64_t> words;
+    const uint64_t chunk_blocks = 1 << 14;
+    const int block_words = PDBFormat::kDeltaBlockBytes / 8;
+    for (uint64_t first_block = 0; first_block < num_blocks; first_block += chunk_blocks) {
+        const uint64_t blocks = std::min(chunk_blocks, num_blocks - first_block);
+        words.assign(blocks * block_words, 0);
+        for (uint64_t b = 0; b < blocks; ++b) {
+            uint64_t* block = &words[b * block_words];
+            const uint64_t first = (first_block + b) * block_ranks;
+            const uint64_t last = std::min<uint64_t>(pdb_vector.size(), first + block_ranks);
+            int bit = 0;
+            for (uint64_t rank = first; rank < last; ++rank) {
+                for (int one = 1; one < code_bits[pdb_vector[rank]]; ++one, ++bit) block[bit >> 6] |= 1ULL << (bit & 63);
+                ++bit; // The terminating zero
+            }
+        }
+        file.write(reinterpret_cast<const char*>(words.data()), words.size() * sizeof(uint64_t));
+    }
+    std::cout << "Delta blocks: " << block_ranks << " ranks per " << PDBFormat::kDeltaBlockBytes << " bytes, "
+              << num_blocks * PDBFormat::kDeltaBlockBytes << " bytes" << std::endl;
+}
+
+template <int kRows, int kCols>
+void BasicGeneratePDB<kRows, kCols>::ClearMemory() {
+    pdb_vector.clear();
+    pdb_vector.shrink_to_fit();
+    multipliers.clear();
+    multipliers.shrink_to_fit();
+
+    closed_set_bits.clear();
+    closed_set_bits.shrink_to_fit();
+    closed_multipliers.clear();
+    closed_multipliers.shrink_to_fit();
+    std::cout << "Memory released for pdb.\n";
+}
+
+template <int kRows, int kCols>
+void BasicGeneratePDB<kRows, kCols>::RemoveElemFromPattern(int val) {
+    pattern.erase(val);
+    auto it = std::lower_bound(sorted_pattern.begin(), sorted_pattern.end(), val);
+
+    if (it != sorted_pattern.end() && *it == val) {
+        sorted_pattern.erase(it);
+    }
+}
+
+template class BasicGeneratePDB<3, 3>;
+template class BasicGeneratePDB<4, 4>;
+template class BasicGeneratePDB<5, 5>;
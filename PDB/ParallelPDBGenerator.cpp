@@ -1,72 +1,175 @@
-#include "GeneratePDB.h"
-#include <thread>
-#include <vector>
-#include <chrono>
-#include <iostream>
-
-// Function to generate and save a PDB
-void GenerateAndSavePDB(const std::unordered_set<int>& pattern, int variant, const std::string& filepath) {
-    GeneratePDB pdb_gen(pattern, variant, filepath);
-    pdb_gen.BuildPDB();
-    pdb_gen.SaveToFile();
-}
-
-int main() {
-    // Define patterns and filepaths
-    std::vector<std::tuple<std::unordered_set<int>, int, std::string>> tasks = {
-	// Test	// {{0,2,3,4,5},1,"DB/test_pdb_v1_0-25.bin"}
-	{{0, 1, 2, 3, 4, 5, 6, 7}, 1, "DB/pdb_v1_0-7.vec.bin"},
-    {{0, 8, 9, 10, 11, 12, 13, 14, 15}, 1, "DB/pdb_v1_0+8-15.vec.bin"},
-    {{0, 1, 2, 3, 4, 5, 6, 7}, 2, "DB/pdb_v2_0-7.vec.bin"},
-    {{0, 8, 9, 10, 11, 12, 13, 14, 15}, 2, "DB/pdb_v2_0+8-15.vec.bin"},
-    };
-
-    /**
-    // Launch threads for each PDB generation task
-    std::vector<std::thread> threads;
-    for (const auto& [pattern, variant, filepath] : tasks) {
-        threads.emplace_back(GenerateAndSavePDB, pattern, variant, filepath);
-    }
-
-    // Wait for all threads to finish
-    for (auto& thread : threads) {
-        thread.join();
-    }
-    */
-
-    // Process each task sequentially
-    for (const auto& [pattern, variant, filepath] : tasks) {
-	auto start = std::chrono::high_resolution_clock::now();
-        std::cout << "Generating PDB for pattern: ";
-        for (int tile : pattern) {
-            std::cout << tile << " ";
-        }
-        std::cout << "(Variant " << variant << ")...\n";
-	
-	auto stop = std::chrono::high_resolution_clock::now();
-	auto duration = std::chrono::duration_cast<std::chrono::microseconds>(stop - start);
-	double minutes = static_cast<double>(duration.count());
-
-    GenerateAndSavePDB(pattern, variant, filepath);
-
-    std::cout << "Saved to: " << filepath << "\n\n";
-
-	std::cout << "Time taken to generate the PDB: "
-          << minutes << " microsecs" << std::endl;
-    }
-
-    std::cout << "All PDBs generated and saved successfully!\n";
-    return 0;
-}
-
-// nohup ./ParallelPDBGenerator > /home/mohammad/logs/PDB_generation.log 2>&1 &
-
-// OUTPUT
-// =================================
-// [0-7]
-// Total Nodes expanded: 518918400
-// PDB built with 57657600 entries
-
-// [0,8-15]
-// Total Nodes expanded: 
+#include "GeneratePDB.h"
+#include "../Search/PerfCounters.h"
+#include <cstring>
+#include <filesystem>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <iostream>
+
+// Function to generate and save a PDB; with perf, the hardware counters of
+// the BFS (on the calling thread) are printed per expanded node
+template <int kRows, int kCols>
+void GenerateAndSavePDB(const std::unordered_set<int>& pattern, int variant, const std::string& filepath,
+                        bool perf = false, PDBFormat::Encoding encoding = PDBFormat::Encoding::Raw) {
+    BasicGeneratePDB<kRows, kCols> pdb_gen(pattern, variant, filepath, encoding);
+    PerfCounters counters;
+    if (perf) counters.Start();
+    pdb_gen.BuildPDB();
+    if (perf) {
+        std::cout << "Hardware counters: ";
+        counters.Stop().Print(std::cout, pdb_gen.NodesExpanded());
+    }
+    pdb_gen.SaveToFile();
+}
+
+// Single PDB on any supported board: --board 3x3|4x4|5x5
+bool GenerateOnBoard(const std::string& board, const std::unordered_set<int>& pattern, int variant,
+                     const std::string& filepath, bool perf, PDBFormat::Encoding encoding) {
+    if (board == "3x3") {
+        GenerateAndSavePDB<3, 3>(pattern, variant, filepath, perf, encoding);
+    } else if (board == "4x4") {
+        GenerateAndSavePDB<4, 4>(pattern, variant, filepath, perf, encoding);
+    } else if (board == "5x5") {
+        GenerateAndSavePDB<5, 5>(pattern, variant, filepath, perf, encoding);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// "0,1,2,3" -> {0, 1, 2, 3}
+std::unordered_set<int> ParsePattern(const std::string& list) {
+    std::unordered_set<int> pattern;
+    std::istringstream iss(list);
+    std::string tile;
+    while (std::getline(iss, tile, ',')) {
+        if (!tile.empty()) pattern.insert(std::stoi(tile));
+    }
+    return pattern;
+}
+
+int main(int argc, char* argv[]) {
+    // --perf: hardware counters per PDB (Linux perf_event_open)
+    // --huge-pages off|thp|explicit: backing of the PDB and closed set (default thp)
+    // --pattern 0,1,2,3 --output file [--board 3x3|4x4|5x5] [--variant 1|2]:
+    //   one PDB (the pattern includes the blank 0) instead of the 4x4 task list
+    // --mod: variant-1 PDBs hold h mod 2D + 1 (D: largest neighbour difference) in as few bits as that needs
+    // --delta: variant-1 PDBs hold the excess over Manhattan distance, coded in 64-byte blocks
+    bool perf = false;
+    PDBFormat::Encoding encoding = PDBFormat::Encoding::Raw;
+    std::string board = "4x4";
+    std::string pattern_list;
+    std::string output;
+    int variant = 1;
+    for (int i = 1; i < argc; ++i) {
+        HugePages::Policy policy;
+        if (std::strcmp(argv[i], "--perf") == 0) {
+            perf = true;
+        } else if (std::strcmp(argv[i], "--mod") == 0) {
+            encoding = PDBFormat::Encoding::Mod;
+        } else if (std::strcmp(argv[i], "--delta") == 0) {
+            encoding = PDBFormat::Encoding::Delta;
+        } else if (std::strcmp(argv[i], "--huge-pages") == 0 && i + 1 < argc && HugePages::ParsePolicy(argv[i + 1], policy)) {
+            HugePages::SetPolicy(policy);
+            ++i;
+        } else if (std::strcmp(argv[i], "--board") == 0 && i + 1 < argc) {
+            board = argv[++i];
+        } else if (std::strcmp(argv[i], "--variant") == 0 && i + 1 < argc) {
+            variant = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--pattern") == 0 && i + 1 < argc) {
+            pattern_list = argv[++i];
+        } else if (std::strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+            output = argv[++i];
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--perf] [--huge-pages off|thp|explicit] [--mod|--delta]"
+                      << " [--pattern 0,1,2,.. --output file [--board 3x3|4x4|5x5] [--variant 1|2]]\n";
+            return 1;
+        }
+    }
+    if (perf) {
+        PerfCounters probe;
+        if (!probe.Available()) {
+            std::cerr << "Hardware counters unavailable, --perf ignored: " << probe.Error() << "\n";
+            perf = false;
+        }
+    }
+
+    if (!pattern_list.empty() || !output.empty()) {
+        if (pattern_list.empty() || output.empty() || (variant != 1 && variant != 2)) {
+            std::cerr << "--pattern and --output are both needed, --variant is 1 or 2\n";
+            return 1;
+        }
+        std::unordered_set<int> pattern = ParsePattern(pattern_list);
+        pattern.insert(0);
+        std::cout << "Generating " << board << " PDB for pattern " << pattern_list << " (Variant " << variant
+                  << ")...\n";
+        if (!GenerateOnBoard(board, pattern, variant, output, perf, encoding)) {
+            std::cerr << "Unsupported board " << board << " (3x3, 4x4 or 5x5)\n";
+            return 1;
+        }
+        return 0;
+    }
+
+    // Define patterns and filepaths
+    std::vector<std::tuple<std::unordered_set<int>, int, std::string>> tasks = {
+	// Test	// {{0,2,3,4,5},1,"DB/test_pdb_v1_0-25.bin"}
+	{{0, 1, 2, 3, 4, 5, 6, 7}, 1, "DB/pdb_v1_0-7.bin"},
+    {{0, 8, 9, 10, 11, 12, 13, 14, 15}, 1, "DB/pdb_v1_0+8-15.bin"},
+    {{0, 1, 2, 3, 4, 5, 6, 7}, 2, "DB/pdb_v2_0-7.bin"},
+    {{0, 8, 9, 10, 11, 12, 13, 14, 15}, 2, "DB/pdb_v2_0+8-15.bin"},
+    };
+
+    /**
+    // Launch threads for each PDB generation task
+    std::vector<std::thread> threads;
+    for (const auto& [pattern, variant, filepath] : tasks) {
+        threads.emplace_back(GenerateAndSavePDB, pattern, variant, filepath);
+    }
+
+    // Wait for all threads to finish
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    */
+
+    // Tables are generated, never committed
+    std::filesystem::create_directories("DB");
+
+    // Process each task sequentially
+    for (const auto& [pattern, variant, filepath] : tasks) {
+	auto start = std::chrono::high_resolution_clock::now();
+        std::cout << "Generating PDB for pattern: ";
+        for (int tile : pattern) {
+            std::cout << tile << " ";
+        }
+        std::cout << "(Variant " << variant << ")...\n";
+	
+	auto stop = std::chrono::high_resolution_clock::now();
+	auto duration = std::chrono::duration_cast<std::chrono::microseconds>(stop - start);
+	double minutes = static_cast<double>(duration.count());
+
+    GenerateAndSavePDB<4, 4>(pattern, variant, filepath, perf, encoding);
+
+    std::cout << "Saved to: " << filepath << "\n\n";
+
+	std::cout << "Time taken to generate the PDB: "
+          << minutes << " microsecs" << std::endl;
+    }
+
+    std::cout << "All PDBs generated and saved successfully!\n";
+    return 0;
+}
+
+// nohup ./ParallelPDBGenerator > /home/mohammad/logs/PDB_generation.log 2>&1 &
+
+// OUTPUT
+// =================================
+// [0-7]
+// Total Nodes expanded: 518918400
+// PDB built with 57657600 entries
+
+// [0,8-15]
+// Total Nodes expanded: 
 // PDB built with 518918400 entries
\ No newline at end of file
@@ -1,8 +1,11 @@
 #include "../GeneratePDB.h" // Correct include path for separate files
+#include "../../Search/Ranking.h"
 #include <iostream>
 #include <cassert>
 #include <unordered_set>
 #include <array>
+#include <random>
+#include <algorithm>
 
 namespace Test {
     // Helper function to compare two vectors
@@ -149,6 +152,34 @@ namespace Test {
         assert(compareVectors(abstract_state3, unranked_abstract_state3));
         assert(compareArrays(state3, reconstructed_state3));
 
+        // Batched ranking: both kernels, every lane, against compute_rank
+        std::mt19937 rng(7);
+        const int rows = pdb.sorted_closed_pattern.size();
+        for (int round = 0; round < 1000; ++round) {
+            Ranking::Lanes lanes;
+            std::vector<std::vector<int>> states;
+            for (int c = 0; c < Ranking::kLanes; ++c) {
+                std::vector<int> positions(16);
+                for (int p = 0; p < 16; ++p) positions[p] = p;
+                std::shuffle(positions.begin(), positions.end(), rng);
+                positions.resize(rows);
+                for (int i = 0; i < rows; ++i) {
+                    lanes.positions[i][c] = positions[i];
+                    lanes.multipliers[i][c] = static_cast<uint32_t>(pdb.closed_multipliers[i]);
+                }
+                states.push_back(positions);
+            }
+            uint64_t scalar[Ranking::kLanes];
+            uint64_t active[Ranking::kLanes];
+            Ranking::RankScalar(lanes, rows, 0xFF, scalar);
+            Ranking::Rank(lanes, rows, 0xFF, active);
+            for (int c = 0; c < Ranking::kLanes; ++c) {
+                assert(scalar[c] == pdb.compute_rank(states[c], 1));
+                assert(active[c] == scalar[c]);
+            }
+        }
+        std::cout << "Batched ranking (" << Ranking::ToString(Ranking::Active()) << ") matches compute_rank\n";
+
         std::cout << "All ranking-related tests passed!\n";
     }
 }
@@ -158,4 +189,4 @@ int main() {
     return 0;
 }
 
-// g++ -std=c++17 test_ranking.cpp ../GeneratePDB.cpp ../AbstractPuzzlePDB.cpp ../../Puzzle/Puzzle.cpp -o test_ranking -I..
\ No newline at end of file
+// g++ -std=c++17 test_ranking.cpp ../GeneratePDB.cpp ../AbstractPuzzlePDB.cpp ../../Search/HugePages.cpp ../../Search/Ranking.cpp ../../Puzzle/Puzzle.cpp -o test_ranking -I..
\ No newline at end of file
@@ -1,42 +1,42 @@
 #include "Puzzle.h"
 
-std::unordered_map<int, std::pair<int, int>> Puzzle::goal_positions;
+template <int kRows, int kCols>
+std::unordered_map<int, std::pair<int, int>> BasicPuzzle<kRows, kCols>::goal_positions;
 
-void Puzzle::init_goal_positions() {
-    int n = 4;
-    std::vector<std::vector<int>> m(n, std::vector<int>(n, 0));
+template <int kRows, int kCols>
+void BasicPuzzle<kRows, kCols>::init_goal_positions() {
+    std::vector<std::vector<int>> m(kRows, std::vector<int>(kCols, 0));
     int c = 0; // Tile counter
 
-    for (int r = 0; r < n; ++r) {
-        for (int col = 0; col < n; ++col) {
+    for (int r = 0; r < kRows; ++r) {
+        for (int col = 0; col < kCols; ++col) {
             m[r][col] = c++;
         }
     }
 
-    for (int r = 0; r < n; ++r) {
-        for (int col = 0; col < n; ++col) {
+    for (int r = 0; r < kRows; ++r) {
+        for (int col = 0; col < kCols; ++col) {
             int tile = m[r][col];
             goal_positions[tile] = {r, col};
         }
     }
 }
 
-Puzzle::Puzzle(const std::array<int, 16>& initial, int var) : variant(var) {
+template <int kRows, int kCols>
+BasicPuzzle<kRows, kCols>::BasicPuzzle(const Tiles& initial, int var) : variant(var) {
     if (goal_positions.empty()) init_goal_positions();
     tiles = initial;
-    for (int i = 0; i < 16; ++i) {
+    for (int i = 0; i < kCells; ++i) {
         if (tiles[i] == 0) {
-            blank_row = i / 4;
-            blank_col = i % 4;
+            blank_row = i / kCols;
+            blank_col = i % kCols;
             break;
         }
     }
 }
 
-void Puzzle::ApplyAction(Action action) {
-    int original_blank_row = blank_row;
-    int original_blank_col = blank_col;
-
+template <int kRows, int kCols>
+void BasicPuzzle<kRows, kCols>::ApplyAction(Action action) {
     switch (action.dir) {
         case Left: {
             int target_col = blank_col - action.steps;
@@ -46,8 +46,8 @@ void Puzzle::ApplyAction(Action action) {
             }
             // Shift tiles right and move blank left
             for (int c = blank_col; c > target_col; --c) {
-                int current_idx = blank_row * 4 + c;
-                int left_idx = blank_row * 4 + (c - 1);
+                int current_idx = blank_row * kCols + c;
+                int left_idx = blank_row * kCols + (c - 1);
                 std::swap(tiles[current_idx], tiles[left_idx]);
             }
             blank_col = target_col;
@@ -55,14 +55,14 @@ void Puzzle::ApplyAction(Action action) {
         }
         case Right: {
             int target_col = blank_col + action.steps;
-            if (target_col >= 4) {
+            if (target_col >= kCols) {
                 cerr << "Invalid action!" << endl;
                 return;
             }
             // Shift tiles left and move blank right
             for (int c = blank_col; c < target_col; ++c) {
-                int current_idx = blank_row * 4 + c;
-                int right_idx = blank_row * 4 + (c + 1);
+                int current_idx = blank_row * kCols + c;
+                int right_idx = blank_row * kCols + (c + 1);
                 std::swap(tiles[current_idx], tiles[right_idx]);
             }
             blank_col = target_col;
@@ -75,21 +75,21 @@ void Puzzle::ApplyAction(Action action) {
                 return;
             }
             // Swap with tile above
-            int current_idx = blank_row * 4 + blank_col;
-            int up_idx = target_row * 4 + blank_col;
+            int current_idx = blank_row * kCols + blank_col;
+            int up_idx = target_row * kCols + blank_col;
             std::swap(tiles[current_idx], tiles[up_idx]);
             blank_row = target_row;
             break;
         }
         case Down: {
             int target_row = blank_row + action.steps;
-            if (target_row >= 4 || action.steps != 1) { // Only 1 step allowed
+            if (target_row >= kRows || action.steps != 1) { // Only 1 step allowed
                 cerr << "Invalid action!" << endl;
                 return;
             }
             // Swap with tile below
-            int current_idx = blank_row * 4 + blank_col;
-            int down_idx = target_row * 4 + blank_col;
+            int current_idx = blank_row * kCols + blank_col;
+            int down_idx = target_row * kCols + blank_col;
             std::swap(tiles[current_idx], tiles[down_idx]);
             blank_row = target_row;
             break;
@@ -97,7 +97,8 @@ void Puzzle::ApplyAction(Action action) {
     }
 }
 
-void Puzzle::UndoAction(Action action) {
+template <int kRows, int kCols>
+void BasicPuzzle<kRows, kCols>::UndoAction(Action action) {
     Action reverse;
     reverse.steps = action.steps;
     switch (action.dir) {
@@ -109,17 +110,18 @@ void Puzzle::UndoAction(Action action) {
     ApplyAction(reverse);
 }
 
-bool Puzzle::GoalTest() const {
-    for (int i = 0; i < 16; ++i) {
+template <int kRows, int kCols>
+bool BasicPuzzle<kRows, kCols>::GoalTest() const {
+    for (int i = 0; i < kCells; ++i) {
         int tile = tiles[i];
         if (tile == 0) continue; // Skip blank tile
 
         auto& [gr, gc] = goal_positions.at(tile); // Goal position
 
         // Find the current position of the tile in tiles array
-        for(int j = 0; j < 16; ++j) {
+        for(int j = 0; j < kCells; ++j) {
             if(tiles[j] == tile) {
-                if(j/4 != gr || j%4 != gc) return false;
+                if(j/kCols != gr || j%kCols != gc) return false;
                 break;
             }
         }
@@ -130,50 +132,82 @@ bool Puzzle::GoalTest() const {
     return (blank_row == gr0 && blank_col == gc0);
 }
 
-std::vector<Action> Puzzle::GetPossibleActions() const {
+template <int kRows, int kCols>
+std::vector<Action> BasicPuzzle<kRows, kCols>::GetPossibleActions() const {
     std::vector<Action> actions;
     if (variant == 1) {
         // Single-step moves in all directions
         if (blank_col > 0)  actions.push_back(Action{Left, 1});
-        if (blank_col < 3)  actions.push_back(Action{Right, 1});
+        if (blank_col < kCols - 1)  actions.push_back(Action{Right, 1});
         if (blank_row > 0)  actions.push_back(Action{Up, 1});
-        if (blank_row < 3)  actions.push_back(Action{Down, 1});
+        if (blank_row < kRows - 1)  actions.push_back(Action{Down, 1});
     } else { 
-        // Variant 2: Moving up to 3 tiles left or right
-        if (blank_col > 0)  actions.push_back(Action{Left, 1});
-        if (blank_col < 3)  actions.push_back(Action{Right, 1});
+        // Variant 2: Moving any number of tiles of the row left or right
+        // (up to 3 on the 4x4 board; single-step horizontal moves are
+        // generated by the loops below)
         if (blank_row > 0)  actions.push_back(Action{Up, 1});
-        if (blank_row < 3)  actions.push_back(Action{Down, 1});
+        if (blank_row < kRows - 1)  actions.push_back(Action{Down, 1});
 
-        int max_left = min(blank_col, 3);
+        int max_left = blank_col;
         for (int s = 1; s <= max_left; ++s)
             actions.push_back(Action{Left, s});
 
-        int max_right = min(3 - blank_col, 3);
+        int max_right = kCols - 1 - blank_col;
         for (int s = 1; s <= max_right; ++s)
             actions.push_back(Action{Right, s});
     }
     return actions;
 }
 
-void Puzzle::PrintState() const {
-    for (int i = 0; i < 4; ++i) {
-        for (int j = 0; j < 4; ++j) {
-            cout << tiles[i * 4 + j] << "\t";
+template <int kRows, int kCols>
+void BasicPuzzle<kRows, kCols>::PrintState() const {
+    for (int i = 0; i < kRows; ++i) {
+        for (int j = 0; j < kCols; ++j) {
+            cout << tiles[i * kCols + j] << "\t";
         }
         cout << endl;
     }
     cout << endl;
 }
 
-std::array<int, 16> Puzzle::GetTiles() const {
+template <int kRows, int kCols>
+typename BasicPuzzle<kRows, kCols>::Tiles BasicPuzzle<kRows, kCols>::GetTiles() const {
     return tiles;
 }
 
-int Puzzle::GetVariant() const {
+template <int kRows, int kCols>
+int BasicPuzzle<kRows, kCols>::GetVariant() const {
     return variant;
 }
 
-std::pair<int, int> Puzzle::GetBlankPosition() const {
+template <int kRows, int kCols>
+std::pair<int, int> BasicPuzzle<kRows, kCols>::GetBlankPosition() const {
     return {blank_row, blank_col};
-}
\ No newline at end of file
+}
+
+template <int kRows, int kCols>
+bool BasicPuzzle<kRows, kCols>::IsSolvable(const Tiles& tiles) {
+    int seen = 0;
+    int blank = -1;
+    for (int i = 0; i < kCells; ++i) {
+        if (tiles[i] < 0 || tiles[i] >= kCells || (seen & (1 << tiles[i]))) return false;
+        seen |= 1 << tiles[i];
+        if (tiles[i] == 0) blank = i;
+    }
+
+    // Every move is a transposition with the blank and moves the blank one
+    // cell, so the permutation parity equals the parity of the blank's
+    // distance to its goal cell (top-left)
+    int inversions = 0;
+    for (int i = 0; i < kCells; ++i) {
+        for (int j = i + 1; j < kCells; ++j) {
+            if (tiles[i] > tiles[j]) ++inversions;
+        }
+    }
+    int blank_distance = blank / kCols + blank % kCols;
+    return (inversions % 2) == (blank_distance % 2);
+}
+
+template class BasicPuzzle<3, 3>;
+template class BasicPuzzle<4, 4>;
+template class BasicPuzzle<5, 5>;
\ No newline at end of file
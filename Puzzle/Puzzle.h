@@ -5,6 +5,7 @@
 #include <iostream>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 using namespace std;
 
@@ -15,29 +16,50 @@ struct Action {
     int steps;
 };
 
-class Puzzle {
+// Sliding-tile puzzle on a kRows x kCols board, tiles 1..kCells-1 and the
+// blank 0, goal tile i at cell i (blank top-left). The dimensions are
+// template parameters so every board loop has compile-time bounds; the
+// supported sizes (3x3, 4x4, 5x5) are instantiated in Puzzle.cpp. `Puzzle`
+// is the 15-puzzle.
+template <int kRows, int kCols>
+class BasicPuzzle {
 public:
+    static const int kRowCount = kRows;
+    static const int kColCount = kCols;
+    static const int kCells = kRows * kCols;
+    using Tiles = std::array<int, kCells>;
+
     static std::unordered_map<int, std::pair<int, int>> goal_positions;
 
 private:
-    std::array<int, 16> tiles; // Fixed-size array for tiles
+    Tiles tiles;               // Fixed-size array for tiles
     int blank_row;             // Row of the blank tile
     int blank_col;             // Column of the blank tile
     int variant;               // Puzzle variant (1 or 2)
 
 public:
-    Puzzle(const std::array<int, 16>& initial, int var);
+    BasicPuzzle(const Tiles& initial, int var);
     void ApplyAction(Action action);
     void UndoAction(Action action);
     bool GoalTest() const;
     std::vector<Action> GetPossibleActions() const;
     void PrintState() const;
-    std::array<int, 16> GetTiles() const; // Getter for tiles
+    Tiles GetTiles() const; // Getter for tiles
     int GetVariant() const; // Getter for variant
     std::pair<int, int> GetBlankPosition() const; // Getter for blank position
 
+    // True if `tiles` is a permutation of 0..kCells-1 that can reach the goal
+    // (the same set for both variants: a slide is a sequence of single moves)
+    static bool IsSolvable(const Tiles& tiles);
+
 private:
     static void init_goal_positions();
 };
 
+extern template class BasicPuzzle<3, 3>;
+extern template class BasicPuzzle<4, 4>;
+extern template class BasicPuzzle<5, 5>;
+
+using Puzzle = BasicPuzzle<4, 4>;
+
 #endif // PUZZLE_H
\ No newline at end of file
@@ -0,0 +1,44 @@
+#ifndef CHILD_BUCKETS_H
+#define CHILD_BUCKETS_H
+
+#include <array>
+#include <cstdint>
+
+// Children of one IDA* node grouped by f-delta (f(child) - f(parent)).
+//
+// With unit move costs and a consistent heuristic the deltas are small
+// non-negative integers, so popping children bucket by bucket visits them in
+// increasing f without sorting. Each bucket is a bitmask over the child slots;
+// deltas outside [0, kNumBuckets) are clamped, which only affects the order.
+template <typename Child, int kMaxChildren = 8, int kNumBuckets = 8>
+class ChildBuckets {
+public:
+    ChildBuckets() : num_children(0), current_bucket(0), masks{} {}
+
+    void Add(const Child& child, int delta) {
+        if (delta < 0) delta = 0;
+        if (delta >= kNumBuckets) delta = kNumBuckets - 1;
+        children[num_children] = child;
+        masks[delta] |= 1u << num_children;
+        ++num_children;
+    }
+
+    // Next child in increasing f-delta order (insertion order within a bucket)
+    bool Pop(Child& child) {
+        while (current_bucket < kNumBuckets && masks[current_bucket] == 0) ++current_bucket;
+        if (current_bucket == kNumBuckets) return false;
+
+        uint32_t& mask = masks[current_bucket];
+        child = children[__builtin_ctz(mask)];
+        mask &= mask - 1;
+        return true;
+    }
+
+private:
+    std::array<Child, kMaxChildren> children;
+    int num_children;
+    int current_bucket;
+    std::array<uint32_t, kNumBuckets> masks;
+};
+
+#endif // CHILD_BUCKETS_H
@@ -0,0 +1,30 @@
+#include "MovePruningFSM.h"
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+int main() {
+    // Define variants, enumeration depths and filepaths
+    std::vector<std::tuple<int, int, std::string>> tasks = {
+        {1, MovePruningFSM::DefaultDepth(1), "fsm_v1.bin"},
+        {2, MovePruningFSM::DefaultDepth(2), "fsm_v2.bin"},
+    };
+
+    for (const auto& [variant, depth, filepath] : tasks) {
+        auto start = std::chrono::high_resolution_clock::now();
+        std::cout << "Generating move pruning FSM for variant " << variant << " (depth " << depth << ")...\n";
+
+        MovePruningFSM fsm;
+        fsm.Build(variant, depth);
+        fsm.SaveToFile(filepath);
+
+        auto stop = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<double> elapsed = stop - start;
+        std::cout << "Time taken to generate the FSM: " << elapsed.count() << " s\n\n";
+    }
+
+    std::cout << "All FSMs generated and saved successfully!\n";
+    return 0;
+}
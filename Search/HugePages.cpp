@@ -0,0 +1,118 @@
+#include "HugePages.h"
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace HugePages {
+    namespace {
+        std::atomic<Policy> policy{Policy::Transparent};
+        thread_local Backing last_backing = Backing::Heap;
+
+        size_t RoundUp(size_t bytes) { return (bytes + kPageBytes - 1) / kPageBytes * kPageBytes; }
+
+#ifdef __linux__
+        // "always [madvise] never": the bracketed entry is the active mode
+        bool TransparentAvailable() {
+            static const bool available = [] {
+                std::ifstream file("/sys/kernel/mm/transparent_hugepage/enabled");
+                std::string modes;
+                return std::getline(file, modes) && modes.find("[never]") == std::string::npos;
+            }();
+            return available;
+        }
+
+        // Anonymous mapping starting on a 2 MB boundary: over-map by one huge
+        // page and unmap the unaligned head and the rest of the tail
+        void* MapAligned(size_t bytes) {
+            void* raw = mmap(nullptr, bytes + kPageBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (raw == MAP_FAILED) return nullptr;
+            uintptr_t start = reinterpret_cast<uintptr_t>(raw);
+            uintptr_t aligned = (start + kPageBytes - 1) / kPageBytes * kPageBytes;
+            if (aligned > start) munmap(raw, aligned - start);
+            size_t tail = start + bytes + kPageBytes - (aligned + bytes);
+            if (tail > 0) munmap(reinterpret_cast<void*>(aligned + bytes), tail);
+            return reinterpret_cast<void*>(aligned);
+        }
+#endif
+    }
+
+    void SetPolicy(Policy new_policy) { policy.store(new_policy, std::memory_order_relaxed); }
+
+    Policy GetPolicy() { return policy.load(std::memory_order_relaxed); }
+
+    bool ParsePolicy(const std::string& name, Policy& parsed) {
+        if (name == "off") {
+            parsed = Policy::Off;
+        } else if (name == "thp") {
+            parsed = Policy::Transparent;
+        } else if (name == "explicit") {
+            parsed = Policy::Explicit;
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    const char* ToString(Policy value) {
+        switch (value) {
+            case Policy::Off: return "off";
+            case Policy::Transparent: return "thp";
+            case Policy::Explicit: return "explicit";
+        }
+        return "unknown";
+    }
+
+    const char* ToString(Backing backing) {
+        switch (backing) {
+            case Backing::Heap: return "heap";
+            case Backing::SmallPages: return "4 KB pages";
+            case Backing::Transparent: return "transparent huge pages (madvise)";
+            case Backing::Explicit: return "explicit 2 MB huge pages (MAP_HUGETLB)";
+        }
+        return "unknown";
+    }
+
+    void* Allocate(size_t bytes) {
+#ifdef __linux__
+        if (bytes >= kMinBytes) {
+            const size_t mapped = RoundUp(bytes);
+            const Policy current = GetPolicy();
+            if (current == Policy::Explicit) {
+                // Private hugetlb mappings reserve their pages here, so a
+                // shortage fails now rather than at first touch
+                void* p = mmap(nullptr, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+                if (p != MAP_FAILED) {
+                    last_backing = Backing::Explicit;
+                    return p;
+                }
+            }
+            void* p = MapAligned(mapped);
+            if (!p) throw std::bad_alloc();
+            last_backing = Backing::SmallPages;
+            if (current != Policy::Off && TransparentAvailable() && madvise(p, mapped, MADV_HUGEPAGE) == 0) {
+                last_backing = Backing::Transparent;
+            }
+            return p;
+        }
+#endif
+        last_backing = Backing::Heap;
+        return ::operator new(bytes);
+    }
+
+    void Deallocate(void* p, size_t bytes) {
+        if (!p) return;
+#ifdef __linux__
+        if (bytes >= kMinBytes) {
+            munmap(p, RoundUp(bytes)); // Same call for hugetlb and normal mappings
+            return;
+        }
+#endif
+        ::operator delete(p);
+    }
+
+    Backing LastBacking() { return last_backing; }
+}
@@ -0,0 +1,60 @@
+#ifndef HUGE_PAGES_H
+#define HUGE_PAGES_H
+
+#include <cstddef>
+#include <new>
+#include <string>
+#include <vector>
+
+// Large tables (PDBs, the PDB generator's closed set) are looked up at random,
+// so with 4 KB pages almost every lookup is also a TLB miss. Allocations of at
+// least kMinBytes are therefore mmap'ed on 2 MB boundaries and, depending on
+// the process-wide policy, backed by explicit huge pages (MAP_HUGETLB, needs
+// pages reserved in vm.nr_hugepages) or marked for transparent huge pages
+// (madvise). Each step falls back to the next when the kernel refuses it;
+// smaller allocations use operator new.
+namespace HugePages {
+    const size_t kPageBytes = size_t(2) << 20;
+    const size_t kMinBytes = kPageBytes;
+
+    enum class Policy { Off, Transparent, Explicit };
+    enum class Backing { Heap, SmallPages, Transparent, Explicit };
+
+    void SetPolicy(Policy policy);       // Default Transparent
+    Policy GetPolicy();
+    bool ParsePolicy(const std::string& name, Policy& policy); // off, thp or explicit
+    const char* ToString(Policy policy);
+    const char* ToString(Backing backing);
+
+    void* Allocate(size_t bytes);
+    void Deallocate(void* p, size_t bytes);
+    // Backing of this thread's last Allocate
+    Backing LastBacking();
+}
+
+// std::allocator replacement routing through HugePages; stateless, so
+// containers using it swap and move like with std::allocator
+template <typename T>
+struct HugePageAllocator {
+    using value_type = T;
+
+    HugePageAllocator() = default;
+    template <typename U>
+    HugePageAllocator(const HugePageAllocator<U>&) {}
+
+    T* allocate(size_t n) {
+        if (n > static_cast<size_t>(-1) / sizeof(T)) throw std::bad_alloc();
+        return static_cast<T*>(HugePages::Allocate(n * sizeof(T)));
+    }
+    void deallocate(T* p, size_t n) { HugePages::Deallocate(p, n * sizeof(T)); }
+};
+
+template <typename T, typename U>
+bool operator==(const HugePageAllocator<T>&, const HugePageAllocator<U>&) { return true; }
+template <typename T, typename U>
+bool operator!=(const HugePageAllocator<T>&, const HugePageAllocator<U>&) { return false; }
+
+template <typename T>
+using HugePageVector = std::vector<T, HugePageAllocator<T>>;
+
+#endif // HUGE_PAGES_H
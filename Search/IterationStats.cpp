@@ -0,0 +1,50 @@
+#include "IterationStats.h"
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace {
+    bool EndsWith(const std::string& s, const std::string& suffix) {
+        return s.size() >= suffix.size() && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+    }
+}
+
+StatsSink::StatsSink(const std::string& filepath)
+    : out(filepath), json(EndsWith(filepath, ".jsonl") || EndsWith(filepath, ".json")) {
+    if (!out) {
+        std::cerr << "Failed to open statistics file: " << filepath << "\n";
+        return;
+    }
+    if (!json) {
+        out << "solver,puzzle,iteration,bound,solved,nodes_expanded,nodes_generated,wall_time_s,"
+               "heuristic_evals,tt_probes,tt_hit_rate,branching_factor\n";
+    }
+}
+
+bool StatsSink::IsOpen() const {
+    return out.is_open();
+}
+
+void StatsSink::Write(const std::string& solver, int puzzle_num, const IterationStats& stats) {
+    if (!out) return;
+
+    std::ostringstream line;
+    line << std::setprecision(6);
+    if (json) {
+        line << "{\"solver\":\"" << solver << "\",\"puzzle\":" << puzzle_num
+             << ",\"iteration\":" << stats.iteration << ",\"bound\":" << stats.bound
+             << ",\"solved\":" << (stats.solved ? "true" : "false")
+             << ",\"nodes_expanded\":" << stats.nodes_expanded << ",\"nodes_generated\":" << stats.nodes_generated
+             << ",\"wall_time_s\":" << stats.wall_time << ",\"heuristic_evals\":" << stats.heuristic_evals
+             << ",\"tt_probes\":" << stats.tt_probes << ",\"tt_hit_rate\":" << stats.TTHitRate()
+             << ",\"branching_factor\":" << stats.BranchingFactor() << "}\n";
+    } else {
+        line << solver << ',' << puzzle_num << ',' << stats.iteration << ',' << stats.bound << ','
+             << (stats.solved ? 1 : 0) << ',' << stats.nodes_expanded << ',' << stats.nodes_generated << ','
+             << stats.wall_time << ',' << stats.heuristic_evals << ',' << stats.tt_probes << ',' << stats.TTHitRate() << ','
+             << stats.BranchingFactor() << '\n';
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    out << line.str() << std::flush;
+}
@@ -0,0 +1,46 @@
+#ifndef ITERATION_STATS_H
+#define ITERATION_STATS_H
+
+#include <fstream>
+#include <mutex>
+#include <string>
+
+// Counters of one IDA* iteration, filled by the solver and handed to the
+// iteration callback. All counts cover this iteration only.
+struct IterationStats {
+    int iteration = 0;            // 1-based
+    int bound = 0;
+    bool solved = false;
+    long long nodes_expanded = 0;  // Nodes whose children were produced
+    long long nodes_generated = 0; // Children evaluated, searched or not
+    double wall_time = 0.0;       // Seconds
+    long long heuristic_evals = 0;
+    long long tt_probes = 0;      // Transposition table
+    long long tt_hits = 0;        // Probes that cut the node off
+
+    double BranchingFactor() const {
+        return nodes_expanded ? static_cast<double>(nodes_generated) / nodes_expanded : 0.0;
+    }
+    double TTHitRate() const {
+        return tt_probes ? static_cast<double>(tt_hits) / tt_probes : 0.0;
+    }
+};
+
+// Appends one record per iteration to a single file shared by all solver
+// threads. Files ending in ".jsonl" or ".json" get JSON lines, anything else
+// CSV with a header row. Writes are serialized by a mutex, which is fine at
+// iteration granularity.
+class StatsSink {
+public:
+    explicit StatsSink(const std::string& filepath);
+
+    bool IsOpen() const;
+    void Write(const std::string& solver, int puzzle_num, const IterationStats& stats);
+
+private:
+    std::ofstream out;
+    bool json;
+    std::mutex mutex;
+};
+
+#endif // ITERATION_STATS_H
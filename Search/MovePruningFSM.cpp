@@ -0,0 +1,260 @@
+#include "MovePruningFSM.h"
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <queue>
+#include <unordered_map>
+
+MovePruningFSM::MovePruningFSM() : variant(0), num_forbidden(0) {}
+
+int MovePruningFSM::MoveIndex(const Action& action) {
+    switch (action.dir) {
+        case Left:  return action.steps - 1;
+        case Right: return 3 + action.steps - 1;
+        case Up:    return 6;
+        case Down:  return 7;
+    }
+    return 0;
+}
+
+Action MovePruningFSM::MoveAction(int move) {
+    if (move < 3) return Action{Left, move + 1};
+    if (move < 6) return Action{Right, move - 2};
+    return Action{(move == 6) ? Up : Down, 1};
+}
+
+uint64_t MovePruningFSM::PackTiles(const std::array<int, 16>& tiles) {
+    uint64_t key = 0;
+    for (int i = 0; i < 16; ++i) {
+        key |= static_cast<uint64_t>(tiles[i]) << (4 * i);
+    }
+    return key;
+}
+
+std::vector<int> MovePruningFSM::LegalMoves(const Puzzle& puzzle) {
+    std::vector<int> moves;
+    for (const auto& action : puzzle.GetPossibleActions()) {
+        moves.push_back(MoveIndex(action));
+    }
+    std::sort(moves.begin(), moves.end());
+    moves.erase(std::unique(moves.begin(), moves.end()), moves.end());
+    return moves;
+}
+
+std::vector<std::vector<int>> MovePruningFSM::FindForbiddenStrings(int max_depth) const {
+    // A string is encoded as a leading 1 followed by its moves in base
+    // kNumMoves, so codes are unique across lengths
+    std::array<std::unordered_map<uint64_t, uint64_t>, 16> canonical;
+    std::vector<Puzzle> start_states;
+
+    // BFS from every blank position. Parents are dequeued in shortlex order and
+    // children generated in move order, so the first string to reach a state is
+    // the shortlex-smallest one
+    for (int p = 0; p < 16; ++p) {
+        std::array<int, 16> tiles;
+        for (int i = 0; i < 16; ++i) tiles[i] = i;
+        std::swap(tiles[0], tiles[p]);
+        start_states.emplace_back(tiles, variant);
+
+        std::queue<std::tuple<Puzzle, uint64_t, int>> q;
+        canonical[p][PackTiles(tiles)] = 1;
+        q.emplace(start_states.back(), 1, 0);
+
+        while (!q.empty()) {
+            auto [puzzle, code, depth] = q.front();
+            q.pop();
+            if (depth == max_depth) continue;
+
+            for (int move : LegalMoves(puzzle)) {
+                Puzzle child = puzzle;
+                child.ApplyAction(MoveAction(move));
+                uint64_t key = PackTiles(child.GetTiles());
+                if (canonical[p].find(key) == canonical[p].end()) {
+                    uint64_t child_code = code * kNumMoves + move;
+                    canonical[p][key] = child_code;
+                    q.emplace(child, child_code, depth + 1);
+                }
+            }
+        }
+    }
+
+    // DFS over strings that are canonical from at least one blank position.
+    // `live` holds the positions where the current prefix is canonical; once a
+    // prefix is dominated from a position, so is every extension of it
+    std::vector<std::vector<int>> forbidden;
+    std::vector<int> moves;
+
+    std::function<void(uint64_t, const std::vector<std::pair<int, Puzzle>>&)> extend =
+        [&](uint64_t code, const std::vector<std::pair<int, Puzzle>>& live) {
+            for (int move = 0; move < kNumMoves; ++move) {
+                uint64_t child_code = code * kNumMoves + move;
+                std::vector<std::pair<int, Puzzle>> child_live;
+                bool applicable = false;
+
+                for (const auto& [p, puzzle] : live) {
+                    std::vector<int> legal = LegalMoves(puzzle);
+                    if (std::find(legal.begin(), legal.end(), move) == legal.end()) continue;
+                    applicable = true;
+
+                    Puzzle child = puzzle;
+                    child.ApplyAction(MoveAction(move));
+                    if (canonical[p].at(PackTiles(child.GetTiles())) == child_code) {
+                        child_live.emplace_back(p, child);
+                    }
+                }
+
+                moves.push_back(move);
+                if (applicable && child_live.empty()) {
+                    forbidden.push_back(moves);
+                } else if (!child_live.empty() && static_cast<int>(moves.size()) < max_depth) {
+                    extend(child_code, child_live);
+                }
+                moves.pop_back();
+            }
+        };
+
+    std::vector<std::pair<int, Puzzle>> roots;
+    for (int p = 0; p < 16; ++p) {
+        roots.emplace_back(p, start_states[p]);
+    }
+    extend(1, roots);
+    return forbidden;
+}
+
+void MovePruningFSM::BuildAutomaton(const std::vector<std::vector<int>>& forbidden) {
+    // Trie of the forbidden strings
+    std::vector<std::array<int, kNumMoves>> go(1);
+    std::vector<bool> terminal(1, false);
+    go[0].fill(-1);
+
+    for (const auto& word : forbidden) {
+        int node = 0;
+        for (int move : word) {
+            if (go[node][move] == -1) {
+                go[node][move] = go.size();
+                go.emplace_back();
+                go.back().fill(-1);
+                terminal.push_back(false);
+            }
+            node = go[node][move];
+        }
+        terminal[node] = true;
+    }
+
+    // Aho-Corasick failure links, completing the goto function on the way
+    std::vector<int> fail(go.size(), 0);
+    std::queue<int> q;
+    for (int move = 0; move < kNumMoves; ++move) {
+        int child = go[0][move];
+        if (child == -1) {
+            go[0][move] = 0;
+        } else {
+            fail[child] = 0;
+            q.push(child);
+        }
+    }
+    while (!q.empty()) {
+        int node = q.front();
+        q.pop();
+        if (terminal[fail[node]]) terminal[node] = true;
+
+        for (int move = 0; move < kNumMoves; ++move) {
+            int child = go[node][move];
+            if (child == -1) {
+                go[node][move] = go[fail[node]][move];
+            } else {
+                fail[child] = go[fail[node]][move];
+                q.push(child);
+            }
+        }
+    }
+
+    // Drop the terminal states; transitions into them become kPruned
+    std::vector<int> remap(go.size(), kPruned);
+    int num_states = 0;
+    for (size_t node = 0; node < go.size(); ++node) {
+        if (!terminal[node]) remap[node] = num_states++;
+    }
+
+    table.assign(static_cast<size_t>(num_states) * kNumMoves, kPruned);
+    for (size_t node = 0; node < go.size(); ++node) {
+        if (terminal[node]) continue;
+        for (int move = 0; move < kNumMoves; ++move) {
+            table[remap[node] * kNumMoves + move] = remap[go[node][move]];
+        }
+    }
+}
+
+void MovePruningFSM::Build(int variant_, int max_depth) {
+    variant = variant_;
+    auto forbidden = FindForbiddenStrings(max_depth);
+    num_forbidden = forbidden.size();
+    BuildAutomaton(forbidden);
+    std::cout << "Move pruning FSM (variant " << variant << ", depth " << max_depth << "): "
+              << num_forbidden << " forbidden strings, " << NumStates() << " states" << std::endl;
+}
+
+bool MovePruningFSM::SaveToFile(const std::string& filepath) const {
+    std::ofstream file(filepath, std::ios::binary);
+    if (!file) {
+        std::cerr << "Error opening file: " << filepath << std::endl;
+        return false;
+    }
+
+    int32_t header[2] = {variant, NumStates()};
+    uint64_t forbidden_count = num_forbidden;
+    file.write(reinterpret_cast<const char*>(header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(&forbidden_count), sizeof(forbidden_count));
+    file.write(reinterpret_cast<const char*>(table.data()), table.size() * sizeof(int32_t));
+    std::cout << "Move pruning FSM saved to " << filepath << std::endl;
+    return static_cast<bool>(file);
+}
+
+bool MovePruningFSM::LoadFromFile(const std::string& filepath) {
+    std::ifstream file(filepath, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+
+    int32_t header[2] = {0, 0};
+    uint64_t forbidden_count = 0;
+    file.read(reinterpret_cast<char*>(header), sizeof(header));
+    file.read(reinterpret_cast<char*>(&forbidden_count), sizeof(forbidden_count));
+    if (!file || header[1] <= 0) {
+        std::cerr << "Invalid move pruning FSM: " << filepath << std::endl;
+        return false;
+    }
+
+    table.resize(static_cast<size_t>(header[1]) * kNumMoves);
+    file.read(reinterpret_cast<char*>(table.data()), table.size() * sizeof(int32_t));
+    if (!file) {
+        std::cerr << "Truncated move pruning FSM: " << filepath << std::endl;
+        table.clear();
+        return false;
+    }
+
+    variant = header[0];
+    num_forbidden = forbidden_count;
+    std::cout << "Move pruning FSM loaded from " << filepath << std::endl;
+    return true;
+}
+
+void MovePruningFSM::LoadOrBuild(const std::string& filepath, int variant_, int max_depth) {
+    if (LoadFromFile(filepath) && variant == variant_) return;
+    Build(variant_, max_depth);
+    SaveToFile(filepath);
+}
+
+int MovePruningFSM::NumStates() const {
+    return table.size() / kNumMoves;
+}
+
+size_t MovePruningFSM::NumForbidden() const {
+    return num_forbidden;
+}
+
+int MovePruningFSM::GetVariant() const {
+    return variant;
+}
@@ -0,0 +1,58 @@
+#ifndef MOVE_PRUNING_FSM_H
+#define MOVE_PRUNING_FSM_H
+
+#include "../Puzzle/Puzzle.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Finite-state-machine duplicate pruning (Taylor & Korf).
+//
+// A move string is forbidden when, from every blank position where it can be
+// applied, a shorter (or equally long and lexicographically smaller) string
+// produces the same state. Forbidden strings up to `max_depth` moves are found
+// offline by BFS from every blank position, then compiled into an Aho-Corasick
+// automaton. The search keeps one automaton state per node and prunes a child
+// when the transition for its move leads into a forbidden string.
+//
+// Move costs are assumed uniform (every move, including a multi-tile slide,
+// costs 1), which matches the cost model of both IDAstar variants.
+class MovePruningFSM {
+public:
+    static const int kNumMoves = 8;  // Left 1-3, Right 1-3, Up, Down
+    static const int kStart = 0;     // Automaton state at the root
+    static const int kPruned = -1;   // Transition into a forbidden string
+
+    MovePruningFSM();
+
+    void Build(int variant, int max_depth);
+    bool LoadFromFile(const std::string& filepath);
+    bool SaveToFile(const std::string& filepath) const;
+    void LoadOrBuild(const std::string& filepath, int variant, int max_depth);
+
+    static int MoveIndex(const Action& action);
+    static int DefaultDepth(int variant) { return (variant == 1) ? 12 : 8; }
+
+    // Automaton state after `action`, or kPruned if the child is a duplicate
+    int Next(int state, const Action& action) const {
+        return table[state * kNumMoves + MoveIndex(action)];
+    }
+
+    int NumStates() const;
+    size_t NumForbidden() const;
+    int GetVariant() const;
+
+private:
+    int variant;
+    size_t num_forbidden;
+    std::vector<int32_t> table; // [state * kNumMoves + move]
+
+    static Action MoveAction(int move);
+    static uint64_t PackTiles(const std::array<int, 16>& tiles);
+    static std::vector<int> LegalMoves(const Puzzle& puzzle);
+
+    std::vector<std::vector<int>> FindForbiddenStrings(int max_depth) const;
+    void BuildAutomaton(const std::vector<std::vector<int>>& forbidden);
+};
+
+#endif // MOVE_PRUNING_FSM_H
@@ -0,0 +1,131 @@
+#include "Numa.h"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace Numa {
+    namespace {
+        // "0-3,8-11" -> 0 1 2 3 8 9 10 11
+        std::vector<int> ParseList(const std::string& list) {
+            std::vector<int> values;
+            std::istringstream iss(list);
+            std::string range;
+            while (std::getline(iss, range, ',')) {
+                if (range.empty() || range == "\n") continue;
+                size_t dash = range.find('-');
+                int first = std::stoi(range.substr(0, dash));
+                int last = (dash == std::string::npos) ? first : std::stoi(range.substr(dash + 1));
+                for (int value = first; value <= last; ++value) values.push_back(value);
+            }
+            return values;
+        }
+
+        std::string ReadLine(const std::string& path) {
+            std::ifstream file(path);
+            std::string line;
+            std::getline(file, line);
+            return line;
+        }
+
+        // "Node 0 MemFree:   5116332 kB"
+        uint64_t FreeBytes(int node) {
+            std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/meminfo");
+            std::string line;
+            while (std::getline(file, line)) {
+                size_t pos = line.find("MemFree:");
+                if (pos != std::string::npos) return std::stoull(line.substr(pos + 8)) * 1024;
+            }
+            return 0;
+        }
+
+#ifdef __linux__
+        const int kMaxNodes = 1024;
+
+        bool Mbind(void* p, size_t bytes, int mode, const std::vector<int>& node_ids) {
+            unsigned long mask[kMaxNodes / (8 * sizeof(unsigned long))] = {};
+            for (int id : node_ids) {
+                if (id < 0 || id >= kMaxNodes) return false;
+                mask[id / (8 * sizeof(unsigned long))] |= 1UL << (id % (8 * sizeof(unsigned long)));
+            }
+            // mbind needs a page-aligned start; widening to whole pages is harmless
+            const uintptr_t page = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+            uintptr_t start = reinterpret_cast<uintptr_t>(p) / page * page;
+            uintptr_t end = (reinterpret_cast<uintptr_t>(p) + bytes + page - 1) / page * page;
+            return syscall(SYS_mbind, start, end - start, mode, mask, kMaxNodes, MPOL_MF_MOVE) == 0;
+        }
+#endif
+    }
+
+    bool ParsePolicy(const std::string& name, Policy& policy) {
+        if (name == "off") {
+            policy = Policy::Off;
+        } else if (name == "replicate") {
+            policy = Policy::Replicate;
+        } else if (name == "interleave") {
+            policy = Policy::Interleave;
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    const char* ToString(Policy policy) {
+        switch (policy) {
+            case Policy::Off: return "off";
+            case Policy::Replicate: return "replicate";
+            case Policy::Interleave: return "interleave";
+        }
+        return "unknown";
+    }
+
+    std::vector<Node> Nodes() {
+        std::vector<Node> nodes;
+        for (int id : ParseList(ReadLine("/sys/devices/system/node/online"))) {
+            std::vector<int> cpus = ParseList(ReadLine("/sys/devices/system/node/node" + std::to_string(id) + "/cpulist"));
+            if (!cpus.empty()) nodes.push_back(Node{id, cpus, FreeBytes(id)});
+        }
+        if (nodes.empty()) {
+            Node all{0, {}, 0};
+            for (int cpu = 0; cpu < static_cast<int>(std::max(1u, std::thread::hardware_concurrency())); ++cpu) {
+                all.cpus.push_back(cpu);
+            }
+            nodes.push_back(all);
+        }
+        return nodes;
+    }
+
+#ifdef __linux__
+
+    bool BindThread(const Node& node) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        for (int cpu : node.cpus) {
+            if (cpu < CPU_SETSIZE) CPU_SET(cpu, &set);
+        }
+        return sched_setaffinity(0, sizeof(set), &set) == 0;
+    }
+
+    bool BindMemory(void* p, size_t bytes, int node) { return Mbind(p, bytes, MPOL_BIND, {node}); }
+
+    bool InterleaveMemory(void* p, size_t bytes, const std::vector<Node>& nodes) {
+        std::vector<int> ids;
+        for (const auto& node : nodes) ids.push_back(node.id);
+        return Mbind(p, bytes, MPOL_INTERLEAVE, ids);
+    }
+
+#else
+
+    bool BindThread(const Node&) { return false; }
+    bool BindMemory(void*, size_t, int) { return false; }
+    bool InterleaveMemory(void*, size_t, const std::vector<Node>&) { return false; }
+
+#endif
+}
@@ -0,0 +1,37 @@
+#ifndef NUMA_H
+#define NUMA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// NUMA topology and placement through sysfs and raw syscalls (no libnuma).
+// PDB lookups are memory-latency bound, so a worker should read a table
+// replica on its own node; when replicas do not fit, interleaving the single
+// copy across nodes at least spreads the remote accesses evenly.
+namespace Numa {
+    struct Node {
+        int id;
+        std::vector<int> cpus;
+        uint64_t free_bytes;
+    };
+
+    enum class Policy { Off, Replicate, Interleave };
+
+    bool ParsePolicy(const std::string& name, Policy& policy); // off, replicate or interleave
+    const char* ToString(Policy policy);
+
+    // Online nodes with at least one CPU, from /sys/devices/system/node;
+    // a single pseudo-node with all CPUs when sysfs has no NUMA information
+    std::vector<Node> Nodes();
+
+    // Restricts the calling thread to the node's CPUs
+    bool BindThread(const Node& node);
+    // Moves the pages of [p, p + bytes) to the node (MPOL_BIND) or spreads
+    // them round-robin over the nodes (MPOL_INTERLEAVE), now and on later faults
+    bool BindMemory(void* p, size_t bytes, int node);
+    bool InterleaveMemory(void* p, size_t bytes, const std::vector<Node>& nodes);
+}
+
+#endif // NUMA_H
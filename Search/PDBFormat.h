@@ -0,0 +1,182 @@
+#ifndef PDB_FORMAT_H
+#define PDB_FORMAT_H
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+
+// On-disk layout of the pattern databases written by GeneratePDB and read by
+// the solvers' PatternDatabase. Every table starts with a Header naming its
+// encoding and variant (the original headerless tables are refused, since
+// nothing tells which variant wrote them):
+//   Raw:  one byte per rank.
+//   Mod:  variant 1. The exact h mod modulus in ModBits(modulus) bits per
+//         rank, packed low bits first, the all-ones code for unreachable
+//         ranks. modulus is 2D + 1 for the largest difference D between
+//         entries of pattern states one tile step apart, so the search
+//         decodes a child from its parent's h; a root's h is summed from the
+//         differences along a descent to a state with no lower neighbour,
+//         which only the goal is.
+//   Min:  one byte per group of group_size adjacent ranks, holding the
+//         group's minimum (lossy, still admissible); rank r reads entry
+//         r / group_size. Written by CompressPDB from a raw table.
+//   Delta: variant 1. Entries are the pattern tiles' Manhattan distance
+//         plus twice a small excess (h - MD is even). The excess is coded
+//         in 64-byte blocks of group_size ranks each, so every block
+//         decodes on its own: rank i of a block is the i-th unary code
+//         (s one bits, then a zero, low bits first), and symbols[s] is its
+//         excess / 2. Symbols are ordered by frequency, which makes the
+//         codes close to the entropy of the excess.
+namespace PDBFormat {
+    enum class Encoding : uint32_t { Raw = 0, Mod = 1, Min = 2, Delta = 3 };
+
+    // The last byte is the header version: 2 added symbols, which moved the
+    // anchors and tables of version-1 files; 3 marks variant-2 tables that
+    // charge each pattern its share of a slide, and raw tables with a header;
+    // 4 replaced the mod-3 anchors and lowered entries by a modulus
+    const char kMagic[8] = {'S', 'T', 'P', 'P', 'D', 'B', '\0', '\4'};
+    const int kVersionByte = 7;
+    const int kMaxModBits = 8;        // A code is read from two bytes
+    const int kDeltaBlockBytes = 64;  // One cache line
+    const int kDeltaSymbols = 32;     // Largest excess / 2 is kDeltaSymbols - 1
+
+    struct Header {
+        char magic[8];
+        uint32_t encoding;
+        uint32_t variant;
+        uint64_t num_states;
+        uint64_t modulus;    // Mod: 2D + 1, 0 otherwise
+        uint64_t group_size; // Ranks per entry (Min) or per block (Delta), 1 otherwise
+        uint8_t symbols[kDeltaSymbols]; // Delta: excess / 2 of each unary code
+    };
+
+    inline const char* ToString(Encoding encoding) {
+        switch (encoding) {
+            case Encoding::Raw: return "raw";
+            case Encoding::Mod: return "mod";
+            case Encoding::Min: return "min";
+            case Encoding::Delta: return "delta";
+        }
+        return "unknown";
+    }
+
+    // Bits per code: the residues 0..modulus - 1 and the unreachable code
+    inline int ModBits(uint64_t modulus) {
+        int bits = 1;
+        while ((uint64_t(1) << bits) <= modulus) ++bits;
+        return bits;
+    }
+    inline uint8_t ModUnreachable(int bits) { return static_cast<uint8_t>((1u << bits) - 1); }
+    // One byte of padding, so the last code reads two bytes like the others
+    inline uint64_t ModBytes(uint64_t num_states, int bits) { return (num_states * bits + 7) / 8 + 1; }
+    inline uint64_t MinBytes(uint64_t num_states, uint64_t group_size) {
+        return (num_states + group_size - 1) / group_size;
+    }
+
+    inline uint8_t ModCode(const uint8_t* packed, uint64_t rank, int bits) {
+        const uint64_t bit = rank * bits;
+        uint16_t two;
+        std::memcpy(&two, packed + (bit >> 3), sizeof(two));
+        return static_cast<uint8_t>((two >> (bit & 7)) & ((1u << bits) - 1));
+    }
+
+    // Broadword select (no branches on the data): byte i of ByteCounts(x)
+    // is the number of ones in byte i of x, and kSelectInByte[b * 8 + i] the
+    // position of the i-th one of byte b
+    constexpr std::array<uint8_t, 256 * 8> MakeSelectInByte() {
+        std::array<uint8_t, 256 * 8> table{};
+        for (int byte = 0; byte < 256; ++byte) {
+            int found = 0;
+            for (int bit = 0; bit < 8; ++bit) {
+                if (byte & (1 << bit)) table[byte * 8 + found++] = static_cast<uint8_t>(bit);
+            }
+        }
+        return table;
+    }
+    inline constexpr std::array<uint8_t, 256 * 8> kSelectInByte = MakeSelectInByte();
+    const uint64_t kByteOnes = 0x0101010101010101ULL;
+    const uint64_t kByteHighs = 0x8080808080808080ULL;
+
+    inline uint64_t ByteCounts(uint64_t x) {
+        x = x - ((x >> 1) & 0x5555555555555555ULL);
+        x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+        return (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    }
+
+    // Position of the index-th one bit of x (index < ones in x)
+    inline int Select64(uint64_t x, uint32_t index) {
+        const uint64_t prefix = ByteCounts(x) * kByteOnes;                   // Byte i: ones in bytes 0..i
+        const uint64_t at_most = ((index * kByteOnes | kByteHighs) - prefix) & kByteHighs; // prefix <= index
+        const int byte = static_cast<int>(((at_most >> 7) * kByteOnes) >> 56);
+        const uint32_t before = static_cast<uint32_t>(((prefix << 8) >> (byte * 8)) & 0xFF);
+        return byte * 8 + kSelectInByte[((x >> (byte * 8)) & 0xFF) * 8 + index - before];
+    }
+
+    // Unary code number index of a Delta block: the run of one bits ending
+    // at its index-th zero bit. The word holding that zero is found from
+    // running zero counts and the bit by Select64, so a lookup touches only
+    // the block's cache line and mispredicts little.
+    inline uint8_t DeltaSymbol(const uint8_t* block, uint32_t index) {
+        uint64_t words[kDeltaBlockBytes / 8];
+        std::memcpy(words, block, sizeof(words));
+        int w = 0;
+        uint32_t before = 0; // Zeros in the words below w
+        uint32_t upto = 0;
+        for (int v = 0; v < kDeltaBlockBytes / 8 - 1; ++v) {
+            upto += static_cast<uint32_t>((ByteCounts(~words[v]) * kByteOnes) >> 56);
+            const bool past = upto <= index;
+            w += past;
+            before = past ? upto : before;
+        }
+        const int bit = Select64(~words[w], index - before);
+
+        // Ones right below the zero, continuing into lower words
+        int run = (bit == 0) ? 0 : __builtin_clzll(~(words[w] << (64 - bit)));
+        if (run == bit) {
+            for (int v = w - 1; v >= 0; --v) {
+                if (words[v] != ~0ULL) {
+                    run += __builtin_clzll(~words[v]);
+                    break;
+                }
+                run += 64;
+            }
+        }
+        return static_cast<uint8_t>(run);
+    }
+
+    inline void WriteHeader(std::ostream& out, Encoding encoding, int variant, uint64_t num_states,
+                            uint64_t modulus = 0, uint64_t group_size = 1, const uint8_t* symbols = nullptr) {
+        Header header;
+        std::memcpy(header.magic, kMagic, sizeof(kMagic));
+        header.encoding = static_cast<uint32_t>(encoding);
+        header.variant = static_cast<uint32_t>(variant);
+        header.num_states = num_states;
+        header.modulus = modulus;
+        header.group_size = group_size;
+        std::memset(header.symbols, 0, sizeof(header.symbols));
+        if (symbols) std::memcpy(header.symbols, symbols, sizeof(header.symbols));
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+
+    enum class HeaderStatus { None, Current, OtherVersion };
+
+    // Reads a header if the stream starts with one of this version; rewinds
+    // on a headerless file. A header of another version is reported without
+    // reading its fields, whose layout differs.
+    inline HeaderStatus ReadHeader(std::istream& in, Header& header) {
+        const std::streampos start = in.tellg();
+        if (in.read(header.magic, sizeof(header.magic)) && std::memcmp(header.magic, kMagic, kVersionByte) == 0) {
+            if (header.magic[kVersionByte] != kMagic[kVersionByte]) return HeaderStatus::OtherVersion;
+            if (in.read(reinterpret_cast<char*>(&header) + sizeof(header.magic), sizeof(header) - sizeof(header.magic))) {
+                return HeaderStatus::Current;
+            }
+        }
+        in.clear();
+        in.seekg(start);
+        return HeaderStatus::None;
+    }
+}
+
+#endif // PDB_FORMAT_H
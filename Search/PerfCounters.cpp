@@ -0,0 +1,189 @@
+#include "PerfCounters.h"
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+PerfSample PerfSample::Zero() {
+    PerfSample sample;
+    for (long long& value : sample.values) value = 0;
+    return sample;
+}
+
+const char* PerfSample::Name(Event event) {
+    switch (event) {
+        case Cycles: return "cycles";
+        case Instructions: return "instructions";
+        case LLCMisses: return "llc_misses";
+        case DTLBMisses: return "dtlb_misses";
+        case BranchMisses: return "branch_misses";
+        case kNumEvents: break;
+    }
+    return "unknown";
+}
+
+PerfSample& PerfSample::operator+=(const PerfSample& other) {
+    for (int e = 0; e < kNumEvents; ++e) {
+        values[e] = (values[e] >= 0 && other.values[e] >= 0) ? values[e] + other.values[e] : -1;
+    }
+    return *this;
+}
+
+void PerfSample::Print(std::ostream& out, long long nodes) const {
+    std::ostringstream line;
+    line << std::fixed << std::setprecision(2);
+    for (int e = 0; e < kNumEvents; ++e) {
+        if (!Has(static_cast<Event>(e))) continue;
+        if (line.tellp() > 0) line << ", ";
+        line << Name(static_cast<Event>(e)) << "/node " << PerNode(static_cast<Event>(e), nodes);
+    }
+    if (IPC() >= 0) line << ", IPC " << IPC();
+    out << (line.tellp() > 0 ? line.str() : std::string("no hardware counters")) << "\n";
+}
+
+std::string PerfSample::CsvHeader() {
+    std::string header;
+    for (int e = 0; e < kNumEvents; ++e) header += std::string(e ? "," : "") + Name(static_cast<Event>(e));
+    for (int e = 0; e < kNumEvents; ++e) header += std::string(",") + Name(static_cast<Event>(e)) + "_per_node";
+    return header + ",ipc";
+}
+
+void PerfSample::WriteCsv(std::ostream& out, long long nodes) const {
+    for (int e = 0; e < kNumEvents; ++e) out << (e ? "," : "") << values[e];
+    for (int e = 0; e < kNumEvents; ++e) out << ',' << PerNode(static_cast<Event>(e), nodes);
+    out << ',' << IPC();
+}
+
+#ifdef __linux__
+
+namespace {
+    struct EventConfig {
+        uint32_t type;
+        uint64_t config;
+    };
+
+    uint64_t CacheConfig(uint64_t cache, uint64_t op, uint64_t result) {
+        return cache | (op << 8) | (result << 16);
+    }
+
+    // Candidates per event, first that opens wins. Some PMUs (e.g. AMD) have
+    // no LL cache event and fall back to the generic cache-miss event.
+    int OpenEvent(PerfSample::Event event, bool inherit) {
+        EventConfig candidates[2];
+        int num_candidates = 1;
+        switch (event) {
+            case PerfSample::Cycles:
+                candidates[0] = {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES};
+                break;
+            case PerfSample::Instructions:
+                candidates[0] = {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS};
+                break;
+            case PerfSample::LLCMisses:
+                candidates[0] = {PERF_TYPE_HW_CACHE, CacheConfig(PERF_COUNT_HW_CACHE_LL, PERF_COUNT_HW_CACHE_OP_READ,
+                                                                 PERF_COUNT_HW_CACHE_RESULT_MISS)};
+                candidates[1] = {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES};
+                num_candidates = 2;
+                break;
+            case PerfSample::DTLBMisses:
+                candidates[0] = {PERF_TYPE_HW_CACHE, CacheConfig(PERF_COUNT_HW_CACHE_DTLB, PERF_COUNT_HW_CACHE_OP_READ,
+                                                                 PERF_COUNT_HW_CACHE_RESULT_MISS)};
+                break;
+            case PerfSample::BranchMisses:
+                candidates[0] = {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES};
+                break;
+            case PerfSample::kNumEvents:
+                return -1;
+        }
+
+        for (int c = 0; c < num_candidates; ++c) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = candidates[c].type;
+            attr.config = candidates[c].config;
+            attr.disabled = 1;
+            attr.exclude_kernel = 1; // Allowed up to perf_event_paranoid 2
+            attr.exclude_hv = 1;
+            attr.inherit = inherit ? 1 : 0;
+            attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            int fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+            if (fd >= 0) return fd;
+        }
+        return -1;
+    }
+}
+
+PerfCounters::PerfCounters(bool inherit) {
+    int first_errno = 0;
+    for (int e = 0; e < PerfSample::kNumEvents; ++e) {
+        fds[e] = OpenEvent(static_cast<PerfSample::Event>(e), inherit);
+        if (fds[e] < 0 && first_errno == 0) first_errno = errno;
+    }
+    if (!Available()) {
+        error = std::string("perf_event_open: ") + std::strerror(first_errno) +
+                (first_errno == EACCES || first_errno == EPERM ? " (see kernel.perf_event_paranoid)" : "");
+    }
+}
+
+PerfCounters::~PerfCounters() {
+    for (int fd : fds) {
+        if (fd >= 0) close(fd);
+    }
+}
+
+bool PerfCounters::Available() const {
+    for (int fd : fds) {
+        if (fd >= 0) return true;
+    }
+    return false;
+}
+
+void PerfCounters::Start() {
+    for (int fd : fds) {
+        if (fd < 0) continue;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+PerfSample PerfCounters::Stop() {
+    PerfSample sample;
+    for (int e = 0; e < PerfSample::kNumEvents; ++e) {
+        if (fds[e] < 0) continue;
+        ioctl(fds[e], PERF_EVENT_IOC_DISABLE, 0);
+        uint64_t data[3]; // value, time enabled, time running
+        if (read(fds[e], data, sizeof(data)) != static_cast<ssize_t>(sizeof(data))) continue;
+        if (data[2] == 0) {
+            sample.values[e] = 0; // Never scheduled: nothing ran
+        } else if (data[2] < data[1]) {
+            sample.values[e] = static_cast<long long>(static_cast<double>(data[0]) * data[1] / data[2]);
+        } else {
+            sample.values[e] = static_cast<long long>(data[0]);
+        }
+    }
+    return sample;
+}
+
+#else
+
+PerfCounters::PerfCounters(bool) : error("hardware counters need Linux perf_event_open") {
+    for (int& fd : fds) fd = -1;
+}
+
+PerfCounters::~PerfCounters() {}
+
+bool PerfCounters::Available() const { return false; }
+
+void PerfCounters::Start() {}
+
+PerfSample PerfCounters::Stop() { return PerfSample(); }
+
+#endif
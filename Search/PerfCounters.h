@@ -0,0 +1,61 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <ostream>
+#include <string>
+
+// Hardware counter totals of one measured section. Events the CPU, kernel or
+// permissions (kernel.perf_event_paranoid) do not allow stay at -1.
+struct PerfSample {
+    enum Event { Cycles, Instructions, LLCMisses, DTLBMisses, BranchMisses, kNumEvents };
+
+    long long values[kNumEvents] = {-1, -1, -1, -1, -1};
+
+    // Start value for sums: every event available, all zero
+    static PerfSample Zero();
+
+    static const char* Name(Event event);
+    bool Has(Event event) const { return values[event] >= 0; }
+    double PerNode(Event event, long long nodes) const {
+        return (Has(event) && nodes > 0) ? static_cast<double>(values[event]) / nodes : -1.0;
+    }
+    double IPC() const {
+        return (Has(Cycles) && Has(Instructions) && values[Cycles] > 0)
+                   ? static_cast<double>(values[Instructions]) / values[Cycles] : -1.0;
+    }
+
+    // Sums per-event; an event missing on either side stays missing
+    PerfSample& operator+=(const PerfSample& other);
+
+    // "cycles/node 52.1, instructions/node ..., IPC 1.9" for the available events
+    void Print(std::ostream& out, long long nodes) const;
+    // CSV columns matching CsvHeader(): the raw counts, then per-node values
+    static std::string CsvHeader();
+    void WriteCsv(std::ostream& out, long long nodes) const;
+};
+
+// Linux perf_event_open counters (user space only) of the calling thread, or
+// with inherit of the calling thread and the threads it starts afterwards.
+// Open one per thread and keep it across sections: opening costs a few
+// syscalls, Start/Stop are three ioctls and a read per event. Counters that
+// the PMU multiplexes are scaled by their enabled/running time.
+class PerfCounters {
+public:
+    explicit PerfCounters(bool inherit = false);
+    ~PerfCounters();
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    // True if at least one event could be opened; Error() says why not
+    bool Available() const;
+    const std::string& Error() const { return error; }
+
+    void Start();
+    PerfSample Stop();
+
+private:
+    int fds[PerfSample::kNumEvents];
+    std::string error;
+};
+
+#endif // PERF_COUNTERS_H
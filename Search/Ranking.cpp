@@ -0,0 +1,95 @@
+#include "Ranking.h"
+#include <atomic>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define RANKING_HAVE_AVX2 1
+#endif
+
+namespace Ranking {
+    namespace {
+#ifdef RANKING_HAVE_AVX2
+        // Compiled for AVX2 regardless of the build flags; only called after
+        // the CPU check. Digits are 32-bit, the products and sums 64-bit.
+        __attribute__((target("avx2")))
+        void RankAvx2(const Lanes& lanes, int num_rows, uint64_t* ranks) {
+            __m256i rows[kMaxTiles];
+            __m256i low = _mm256_setzero_si256();  // Lanes 0-3
+            __m256i high = _mm256_setzero_si256(); // Lanes 4-7
+            for (int i = 0; i < num_rows; ++i) {
+                const __m256i position = _mm256_load_si256(reinterpret_cast<const __m256i*>(lanes.positions[i]));
+                __m256i digit = position;
+                for (int j = 0; j < i; ++j) {
+                    // -1 where the earlier tile lies below this one
+                    digit = _mm256_add_epi32(digit, _mm256_cmpgt_epi32(position, rows[j]));
+                }
+                rows[i] = position;
+
+                // _mm256_mul_epu32 multiplies the low 32 bits of each 64-bit lane
+                const __m256i multiplier = _mm256_load_si256(reinterpret_cast<const __m256i*>(lanes.multipliers[i]));
+                low = _mm256_add_epi64(low, _mm256_mul_epu32(_mm256_cvtepu32_epi64(_mm256_castsi256_si128(digit)),
+                                                             _mm256_cvtepu32_epi64(_mm256_castsi256_si128(multiplier))));
+                high = _mm256_add_epi64(high, _mm256_mul_epu32(_mm256_cvtepu32_epi64(_mm256_extracti128_si256(digit, 1)),
+                                                               _mm256_cvtepu32_epi64(_mm256_extracti128_si256(multiplier, 1))));
+            }
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(ranks), low);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(ranks + 4), high);
+        }
+#endif
+
+        Kernel Detect() {
+#ifdef RANKING_HAVE_AVX2
+            if (__builtin_cpu_supports("avx2")) return Kernel::Avx2;
+#endif
+            return Kernel::Scalar;
+        }
+
+        std::atomic<Kernel> active{Detect()};
+    }
+
+    bool Avx2Supported() {
+        static const bool supported = (Detect() == Kernel::Avx2);
+        return supported;
+    }
+
+    Kernel Active() { return active.load(std::memory_order_relaxed); }
+
+    void SetKernel(Kernel kernel) {
+        if (kernel == Kernel::Avx2 && !Avx2Supported()) kernel = Kernel::Scalar;
+        active.store(kernel, std::memory_order_relaxed);
+    }
+
+    const char* ToString(Kernel kernel) {
+        switch (kernel) {
+            case Kernel::Scalar: return "scalar";
+            case Kernel::Avx2: return "avx2";
+        }
+        return "unknown";
+    }
+
+    void RankScalar(const Lanes& lanes, int num_rows, uint32_t lane_mask, uint64_t* ranks) {
+        while (lane_mask) {
+            const int c = __builtin_ctz(lane_mask);
+            lane_mask &= lane_mask - 1;
+            uint64_t rank = 0;
+            uint64_t used_mask = 0;
+            for (int i = 0; i < num_rows; ++i) {
+                const int position = lanes.positions[i][c];
+                const uint64_t digit = position - __builtin_popcountll(used_mask & ((1ULL << position) - 1));
+                rank += digit * lanes.multipliers[i][c];
+                used_mask |= 1ULL << position;
+            }
+            ranks[c] = rank;
+        }
+    }
+
+    void Rank(const Lanes& lanes, int num_rows, uint32_t lane_mask, uint64_t* ranks) {
+#ifdef RANKING_HAVE_AVX2
+        if (Active() == Kernel::Avx2) {
+            RankAvx2(lanes, num_rows, ranks);
+            return;
+        }
+#endif
+        RankScalar(lanes, num_rows, lane_mask, ranks);
+    }
+}
@@ -0,0 +1,42 @@
+#ifndef RANKING_H
+#define RANKING_H
+
+#include <cstdint>
+
+// Batched ranking of pattern states. The solver and the PDB generator rank
+// every child of a node, and the children differ from their parent in only a
+// few tiles, so they are ranked together: lane c holds one state (a child, or
+// in the solver a child and one of its databases) and row i the position of
+// its i-th pattern tile with that tile's rank multiplier. A tile's rank digit
+// is its position minus the earlier tiles placed below it; the AVX2 kernel
+// counts those with 8-lane compares instead of one popcount per tile and
+// state. The kernel is chosen once from the CPU's features, with a scalar
+// fallback.
+namespace Ranking {
+    const int kLanes = 8;
+    const int kMaxTiles = 16;
+
+    // Lanes with fewer tiles than the rows ranked pad with multiplier 0.
+    // Multipliers must fit 32 bits (patterns of up to 10 tiles); larger
+    // patterns are ranked by their owners' scalar code.
+    struct Lanes {
+        alignas(32) int32_t positions[kMaxTiles][kLanes];
+        alignas(32) uint32_t multipliers[kMaxTiles][kLanes];
+    };
+
+    enum class Kernel { Scalar, Avx2 };
+
+    bool Avx2Supported();
+    Kernel Active();                // Avx2 when supported, unless SetKernel chose Scalar
+    void SetKernel(Kernel kernel);  // Avx2 is ignored without CPU support
+    const char* ToString(Kernel kernel);
+
+    // ranks[c] for the lanes in lane_mask, from the first num_rows rows:
+    //   sum over i of (positions[i][c] - #{j < i : positions[j][c] < positions[i][c]}) * multipliers[i][c]
+    // ranks needs kLanes entries; the AVX2 kernel also fills the other lanes
+    // (from whatever they hold).
+    void Rank(const Lanes& lanes, int num_rows, uint32_t lane_mask, uint64_t* ranks);
+    void RankScalar(const Lanes& lanes, int num_rows, uint32_t lane_mask, uint64_t* ranks);
+}
+
+#endif // RANKING_H
@@ -0,0 +1,55 @@
+#ifndef SEARCH_LIMITS_H
+#define SEARCH_LIMITS_H
+
+#include <algorithm>
+#include <atomic>
+
+// Stop flag shared between a driver and any number of running solves.
+// Cancel() may be called from another thread or a signal handler.
+class CancellationToken {
+public:
+    void Cancel() { cancelled.store(true, std::memory_order_relaxed); }
+    bool IsCancelled() const { return cancelled.load(std::memory_order_relaxed); }
+    void Reset() { cancelled.store(false, std::memory_order_relaxed); }
+
+private:
+    std::atomic<bool> cancelled{false};
+};
+
+// Budget of one solve; zero or nullptr disables a limit. The node limit is
+// tested at every node (it may overshoot by the depth of the path being
+// unwound); the clock and the token are polled every kCheckInterval expansions.
+struct SearchLimits {
+    static const long long kCheckInterval = 1 << 10;
+
+    long long max_nodes = 0;                  // Expanded nodes
+    double max_seconds = 0.0;                 // Wall clock, from the start of the solve
+    const CancellationToken* cancel = nullptr;
+
+    bool Unlimited() const { return max_nodes <= 0 && max_seconds <= 0.0 && !cancel; }
+
+    // What is left after a first engine used `nodes` and `seconds` of it
+    SearchLimits Remaining(long long nodes, double seconds) const {
+        SearchLimits rest = *this;
+        if (max_nodes > 0) rest.max_nodes = std::max(1LL, max_nodes - nodes);
+        if (max_seconds > 0.0) rest.max_seconds = std::max(1e-3, max_seconds - seconds);
+        return rest;
+    }
+};
+
+// How a solve ended; MemoryLimit only stops the memory-bounded A* engine
+enum class SolveStatus { Solved, Exhausted, NodeLimit, TimeLimit, Cancelled, MemoryLimit };
+
+inline const char* ToString(SolveStatus status) {
+    switch (status) {
+        case SolveStatus::Solved: return "solved";
+        case SolveStatus::Exhausted: return "exhausted";
+        case SolveStatus::NodeLimit: return "node_limit";
+        case SolveStatus::TimeLimit: return "time_limit";
+        case SolveStatus::Cancelled: return "cancelled";
+        case SolveStatus::MemoryLimit: return "memory_limit";
+    }
+    return "unknown";
+}
+
+#endif // SEARCH_LIMITS_H
@@ -0,0 +1,89 @@
+#include "Telemetry.h"
+#include <algorithm>
+#include <climits>
+#include <iomanip>
+#include <sstream>
+
+Telemetry::Telemetry(int num_workers)
+    : workers(new WorkerCounters[num_workers]), last_expanded(new long long[num_workers]()),
+      num_workers(num_workers), stopping(false) {}
+
+Telemetry::~Telemetry() {
+    Stop();
+}
+
+void Telemetry::Start(double interval_sec, std::ostream& console, std::ostream* csv) {
+    if (reporter.joinable()) return;
+    stopping = false;
+    start_time = std::chrono::steady_clock::now();
+    if (csv) {
+        *csv << "elapsed_s,core,puzzle,bound,depth,nodes_expanded,nodes_generated,nodes_per_sec\n";
+    }
+    reporter = std::thread(&Telemetry::Run, this, std::chrono::duration<double>(interval_sec), std::ref(console), csv);
+}
+
+void Telemetry::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(stop_mutex);
+        stopping = true;
+    }
+    stop_cv.notify_all();
+    if (reporter.joinable()) reporter.join();
+}
+
+void Telemetry::Run(std::chrono::duration<double> interval, std::ostream& console, std::ostream* csv) {
+    auto last_sample = start_time;
+    std::unique_lock<std::mutex> lock(stop_mutex);
+    while (!stop_cv.wait_for(lock, interval, [this] { return stopping; })) {
+        auto now = std::chrono::steady_clock::now();
+        double elapsed = std::chrono::duration<double>(now - start_time).count();
+        double since_last = std::chrono::duration<double>(now - last_sample).count();
+        last_sample = now;
+        Sample(elapsed, since_last, console, csv);
+    }
+}
+
+void Telemetry::Sample(double elapsed, double interval, std::ostream& console, std::ostream* csv) {
+    int active = 0;
+    long long total_expanded = 0;
+    double total_rate = 0.0;
+    int min_bound = INT_MAX, max_bound = 0;
+    std::ostringstream rows;
+
+    for (int i = 0; i < num_workers; ++i) {
+        const WorkerCounters& w = workers[i];
+        long long expanded = w.nodes_expanded.load(std::memory_order_relaxed);
+        // A counter reset by Begin() starts a new rate window
+        long long delta = std::max(0LL, expanded - last_expanded[i]);
+        last_expanded[i] = expanded;
+
+        int puzzle = w.puzzle_num.load(std::memory_order_relaxed);
+        if (puzzle == 0) continue;
+
+        int bound = w.bound.load(std::memory_order_relaxed);
+        double rate = delta / interval;
+        ++active;
+        total_expanded += expanded;
+        total_rate += rate;
+        min_bound = std::min(min_bound, bound);
+        max_bound = std::max(max_bound, bound);
+
+        if (csv) {
+            rows << std::fixed << std::setprecision(1) << elapsed << ','
+                 << w.core_num.load(std::memory_order_relaxed) << ',' << puzzle << ',' << bound << ','
+                 << w.depth.load(std::memory_order_relaxed) << ',' << expanded << ','
+                 << w.nodes_generated.load(std::memory_order_relaxed) << ','
+                 << std::setprecision(0) << rate << '\n';
+        }
+    }
+
+    std::ostringstream line;
+    line << std::fixed << std::setprecision(1) << "[" << elapsed << "s] " << active << " active, "
+         << total_expanded << " expanded, " << std::setprecision(0) << total_rate << " nodes/s";
+    if (active > 0) line << ", bounds " << min_bound << "-" << max_bound;
+    line << "\n";
+
+    // One write per stream keeps lines whole even if other threads print
+    console << line.str() << std::flush;
+    if (csv) *csv << rows.str() << std::flush;
+}
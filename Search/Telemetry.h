@@ -0,0 +1,76 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <thread>
+
+// Lock-free progress counters for the solver threads, sampled by one
+// reporter thread.
+//
+// Each solver owns one WorkerCounters slot and keeps counting in its own
+// locals; every kPublishInterval expansions it publishes them with relaxed
+// atomic stores, so the search loop never locks or touches std::cout. The
+// reporter wakes at a fixed interval, prints one summary line (active
+// workers, total nodes/sec, bound range) and optionally appends one CSV row
+// per active worker (bound, depth, counts, nodes/sec).
+struct alignas(64) WorkerCounters {
+    static const long long kPublishInterval = 1 << 12; // Expansions between publishes
+
+    std::atomic<int> core_num{0};
+    std::atomic<int> puzzle_num{0};      // 0 while idle
+    std::atomic<int> bound{0};
+    std::atomic<int> depth{0};
+    std::atomic<long long> nodes_expanded{0};
+    std::atomic<long long> nodes_generated{0};
+
+    void Begin(int core, int puzzle) {
+        core_num.store(core, std::memory_order_relaxed);
+        nodes_expanded.store(0, std::memory_order_relaxed);
+        nodes_generated.store(0, std::memory_order_relaxed);
+        puzzle_num.store(puzzle, std::memory_order_relaxed);
+    }
+
+    void NewIteration(int new_bound) { bound.store(new_bound, std::memory_order_relaxed); }
+
+    void Publish(long long expanded, long long generated, int current_depth) {
+        nodes_expanded.store(expanded, std::memory_order_relaxed);
+        nodes_generated.store(generated, std::memory_order_relaxed);
+        depth.store(current_depth, std::memory_order_relaxed);
+    }
+
+    void End() { puzzle_num.store(0, std::memory_order_relaxed); }
+};
+
+class Telemetry {
+public:
+    explicit Telemetry(int num_workers);
+    ~Telemetry();
+
+    WorkerCounters& Worker(int id) { return workers[id]; }
+    int NumWorkers() const { return num_workers; }
+
+    // Starts the reporter thread; csv may be nullptr
+    void Start(double interval_sec, std::ostream& console, std::ostream* csv);
+    void Stop();
+
+private:
+    std::unique_ptr<WorkerCounters[]> workers;
+    std::unique_ptr<long long[]> last_expanded; // Reporter-only state
+    int num_workers;
+
+    std::thread reporter;
+    std::mutex stop_mutex;
+    std::condition_variable stop_cv;
+    bool stopping;
+    std::chrono::steady_clock::time_point start_time;
+
+    void Run(std::chrono::duration<double> interval, std::ostream& console, std::ostream* csv);
+    void Sample(double elapsed, double interval, std::ostream& console, std::ostream* csv);
+};
+
+#endif // TELEMETRY_H
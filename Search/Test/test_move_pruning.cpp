@@ -0,0 +1,97 @@
+#include "../MovePruningFSM.h"
+#include <iostream>
+#include <cassert>
+#include <algorithm>
+#include <array>
+#include <random>
+#include <unordered_map>
+
+namespace Test {
+    uint64_t Pack(const std::array<int, 16>& tiles) {
+        uint64_t key = 0;
+        for (int i = 0; i < 16; ++i) key |= static_cast<uint64_t>(tiles[i]) << (4 * i);
+        return key;
+    }
+
+    // Depth-limited DFS recording the shallowest depth each state is reached at
+    void Explore(Puzzle& puzzle, int depth, int max_depth, const MovePruningFSM* fsm, int fsm_state,
+                 std::unordered_map<uint64_t, int>& seen, long long& nodes) {
+        ++nodes;
+        uint64_t key = Pack(puzzle.GetTiles());
+        auto it = seen.find(key);
+        if (it == seen.end() || it->second > depth) seen[key] = depth;
+        if (depth == max_depth) return;
+
+        for (const auto& action : puzzle.GetPossibleActions()) {
+            int child_state = 0;
+            if (fsm) {
+                child_state = fsm->Next(fsm_state, action);
+                if (child_state == MovePruningFSM::kPruned) continue;
+            }
+            puzzle.ApplyAction(action);
+            Explore(puzzle, depth + 1, max_depth, fsm, child_state, seen, nodes);
+            puzzle.UndoAction(action);
+        }
+    }
+
+    // Pruning must keep every state reachable at its shortest distance
+    void testCompleteness(const MovePruningFSM& fsm, int variant, int max_depth) {
+        std::mt19937 gen(variant);
+        for (int trial = 0; trial < 4; ++trial) {
+            std::array<int, 16> tiles;
+            for (int i = 0; i < 16; ++i) tiles[i] = i;
+            std::shuffle(tiles.begin(), tiles.end(), gen);
+
+            Puzzle plain_puzzle(tiles, variant);
+            Puzzle pruned_puzzle(tiles, variant);
+            std::unordered_map<uint64_t, int> plain, pruned;
+            long long plain_nodes = 0, pruned_nodes = 0;
+            Explore(plain_puzzle, 0, max_depth, nullptr, 0, plain, plain_nodes);
+            Explore(pruned_puzzle, 0, max_depth, &fsm, MovePruningFSM::kStart, pruned, pruned_nodes);
+
+            assert(plain.size() == pruned.size());
+            for (const auto& [key, depth] : plain) {
+                assert(pruned.at(key) == depth);
+            }
+            std::cout << "Variant " << variant << " trial " << trial << ": " << plain_nodes
+                      << " nodes without FSM, " << pruned_nodes << " with FSM" << std::endl;
+        }
+    }
+
+    void testMovePruning() {
+        MovePruningFSM fsm1;
+        fsm1.Build(1, 12);
+        assert(fsm1.NumForbidden() > 0);
+        testCompleteness(fsm1, 1, 14);
+
+        MovePruningFSM fsm2;
+        fsm2.Build(2, 6);
+        assert(fsm2.NumForbidden() > 0);
+        testCompleteness(fsm2, 2, 7);
+
+        // Reverse moves are always pruned
+        int state = fsm1.Next(MovePruningFSM::kStart, Action{Left, 1});
+        assert(state != MovePruningFSM::kPruned);
+        assert(fsm1.Next(state, Action{Right, 1}) == MovePruningFSM::kPruned);
+
+        // Two single slides are dominated by one double slide in variant 2
+        state = fsm2.Next(MovePruningFSM::kStart, Action{Left, 1});
+        assert(fsm2.Next(state, Action{Left, 1}) == MovePruningFSM::kPruned);
+
+        // Round trip through the on-disk format
+        assert(fsm2.SaveToFile("test_fsm.bin"));
+        MovePruningFSM loaded;
+        assert(loaded.LoadFromFile("test_fsm.bin"));
+        assert(loaded.NumStates() == fsm2.NumStates());
+        assert(loaded.GetVariant() == 2);
+
+        std::cout << "All move pruning tests passed!\n";
+    }
+}
+
+int main() {
+    Test::testMovePruning();
+    return 0;
+}
+
+// g++ -std=c++17 -O2 test_move_pruning.cpp ../MovePruningFSM.cpp ../../Puzzle/Puzzle.cpp -o test_move_pruning
@@ -0,0 +1,74 @@
+#include "TranspositionTable.h"
+#include <algorithm>
+#include <iostream>
+
+TranspositionTable::TranspositionTable(size_t size_mb) : mask(0), next_search_id(1) {
+    // Largest power-of-two slot count that fits in the requested size
+    size_t max_slots = std::max<size_t>(1, (size_mb << 20) / sizeof(Slot));
+    size_t num_slots = 1;
+    while (num_slots * 2 <= max_slots) num_slots *= 2;
+
+    slots.reset(new Slot[num_slots]);
+    mask = num_slots - 1;
+    Clear();
+    std::cout << "Transposition table: " << num_slots << " slots ("
+              << (num_slots * sizeof(Slot)) / (1 << 20) << " MB)" << std::endl;
+}
+
+uint32_t TranspositionTable::NewSearch() {
+    return next_search_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64_t TranspositionTable::PackState(const std::array<int, 16>& tiles) {
+    uint64_t key = 0;
+    for (int i = 0; i < 16; ++i) {
+        key |= static_cast<uint64_t>(tiles[i]) << (4 * i);
+    }
+    return key;
+}
+
+size_t TranspositionTable::Index(uint64_t key) const {
+    // Fibonacci hashing spreads the low-entropy packed states over the table
+    return (key * 0x9E3779B97F4A7C15ULL) >> 20 & mask;
+}
+
+bool TranspositionTable::Probe(uint64_t key, Entry& entry) const {
+    const Slot& slot = slots[Index(key)];
+    uint64_t data = slot.data.load(std::memory_order_relaxed);
+    uint64_t check = slot.check.load(std::memory_order_relaxed);
+    if ((check ^ data) != key || data == 0) return false;
+
+    entry.search_id = static_cast<uint32_t>(data >> 16);
+    entry.g = (data >> 8) & 0xFF;
+    entry.h_bound = data & 0xFF;
+    return true;
+}
+
+void TranspositionTable::Store(uint64_t key, uint32_t search_id, int g, int h_bound) {
+    g = std::min(g, kMaxValue);
+    h_bound = std::min(h_bound, kMaxValue);
+
+    // Same state from the same search: a lower g makes the entry apply to more
+    // visits; at equal g the larger proven bound wins
+    Entry old;
+    if (Probe(key, old) && old.search_id == search_id) {
+        if (old.g < g) return;
+        if (old.g == g) h_bound = std::max(h_bound, old.h_bound);
+    }
+
+    uint64_t data = (static_cast<uint64_t>(search_id) << 16) | (static_cast<uint64_t>(g) << 8) | h_bound;
+    Slot& slot = slots[Index(key)];
+    slot.data.store(data, std::memory_order_relaxed);
+    slot.check.store(key ^ data, std::memory_order_relaxed);
+}
+
+void TranspositionTable::Clear() {
+    for (size_t i = 0; i <= mask; ++i) {
+        slots[i].data.store(0, std::memory_order_relaxed);
+        slots[i].check.store(0, std::memory_order_relaxed);
+    }
+}
+
+size_t TranspositionTable::NumSlots() const {
+    return mask + 1;
+}
@@ -0,0 +1,55 @@
+#ifndef TRANSPOSITION_TABLE_H
+#define TRANSPOSITION_TABLE_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+// Fixed-size, lossy transposition table for IDA*.
+//
+// Each slot holds one packed 15-puzzle state (16 tiles x 4 bits = 64 bits, so
+// keys are exact) with the g at which its subtree was searched and the bound
+// that subtree proved: h_bound = (smallest f beyond the IDA* bound) - g. A node
+// reached again with g >= stored g and g + h_bound > current bound cannot lead
+// to a solution within the bound and is cut off with f = g + h_bound.
+//
+// Slots are written without locks (Hyatt's XOR scheme: the key is stored XORed
+// with the data word), so a torn write from a concurrent thread fails the key
+// check and simply reads as a miss. Entries are tagged with a search id, so one
+// table can be shared by solver threads working on different puzzles.
+class TranspositionTable {
+public:
+    struct Entry {
+        uint32_t search_id;
+        int g;
+        int h_bound;
+    };
+
+    static const int kMaxValue = 255; // g and h_bound saturate here
+
+    explicit TranspositionTable(size_t size_mb);
+
+    uint32_t NewSearch();
+    static uint64_t PackState(const std::array<int, 16>& tiles);
+
+    bool Probe(uint64_t key, Entry& entry) const;
+    void Store(uint64_t key, uint32_t search_id, int g, int h_bound);
+    void Clear();
+
+    size_t NumSlots() const;
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> check; // key ^ data
+        std::atomic<uint64_t> data;  // search_id << 16 | g << 8 | h_bound
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    size_t mask;
+    std::atomic<uint32_t> next_search_id;
+
+    size_t Index(uint64_t key) const;
+};
+
+#endif // TRANSPOSITION_TABLE_H